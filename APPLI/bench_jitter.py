@@ -0,0 +1,123 @@
+"""
+Send-loop jitter with a busy UI process, in-process thread vs. worker process.
+
+    python3 bench_jitter.py [seconds] [fifo_priority]
+
+The fused poll + send loop runs for the given time (default 5 s) as a
+thread of this process (PIPELINE_MODE "fused"), then in the real-time
+worker process ("process"), and, if a priority is given (default 50; 0
+skips it), in the worker on SCHED_FIFO. Each case runs with an idle UI and
+a busy one: meanwhile a thread of this process emulates UI
+work holding the GIL (pure-Python bursts of 20 ms every 30 ms, as slots,
+JSON and layout callbacks do while the window is resized or scrolled). The
+UDP target is a local socket nobody reads. Without a gamepad the loop still
+runs its poll and sends neutral packets.
+"""
+import socket
+import sys
+import threading
+import time
+
+from controller_state import ControllerState
+from gamepad_reader import GamepadReader
+from logger import Logger
+from pipeline import FusedPipeline
+from rt_process import RealtimeProcess
+from scheduler import DeadlineScheduler
+from settings import SCHED_SWITCH_INTERVAL_S
+from udp_sender import UDPSender
+
+
+class UIHog:
+    """Holds the GIL in bursts from a thread of this process."""
+
+    def __init__(self, burst_s: float = 0.020, idle_s: float = 0.010):
+        self.burst_s = burst_s
+        self.idle_s = idle_s
+        self._running = False
+        self._thread = None
+
+    def __enter__(self):
+        self._running = True
+        self._thread = threading.Thread(target=self._run, daemon=True)
+        self._thread.start()
+        return self
+
+    def __exit__(self, *exc):
+        self._running = False
+        self._thread.join()
+
+    def _run(self):
+        while self._running:
+            end = time.perf_counter() + self.burst_s
+            acc = 0
+            while time.perf_counter() < end:
+                acc += sum(i * i for i in range(200))
+            time.sleep(self.idle_s)
+
+
+def run_thread(seconds: float, target, hog: bool) -> dict:
+    logger = Logger(enable_console=False)
+    state = ControllerState()
+    reader = GamepadReader(state, logger)
+    sender = UDPSender(state, logger)
+    sender.target_address = target
+    pipeline = FusedPipeline(reader, sender, logger)
+    pipeline.report_s = seconds * 10      # stats taken below, once
+    if hog:
+        with UIHog():
+            pipeline.start_pipeline()
+            time.sleep(seconds)
+            stats = pipeline.scheduler.stats()
+    else:
+        pipeline.start_pipeline()
+        time.sleep(seconds)
+        stats = pipeline.scheduler.stats()
+    pipeline.stop_pipeline()
+    return stats
+
+
+def run_process(seconds: float, target, hog: bool, priority: int = 0) -> dict:
+    logger = Logger(enable_console=False)
+    proc = RealtimeProcess(logger, report_s=seconds, target=target, priority=priority,
+                           console=False)
+    proc.log_record.connect(lambda level, text: level == "FAILURE"
+                            and "Controller disconnected" not in text and print(text))
+    got = []
+    proc.tick_stats_reported.connect(got.append)
+    proc.start_pipeline()
+    end = time.monotonic() + seconds * 3 + 10
+    if hog:
+        with UIHog():
+            while not got and time.monotonic() < end:
+                proc.poll()
+                time.sleep(0.02)
+    else:
+        while not got and time.monotonic() < end:
+            proc.poll()
+            time.sleep(0.02)
+    proc.stop_pipeline()
+    return got[0] if got else {}
+
+
+def main():
+    seconds = float(sys.argv[1]) if len(sys.argv) > 1 else 5.0
+    priority = int(sys.argv[2]) if len(sys.argv) > 2 else 50
+    sys.setswitchinterval(SCHED_SWITCH_INTERVAL_S)
+    sink = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sink.bind(("127.0.0.1", 0))
+    target = sink.getsockname()
+
+    cases = [("thread", run_thread), ("process", run_process)]
+    if priority:
+        cases.append((f"process FIFO {priority}",
+                      lambda sec, tgt, hog: run_process(sec, tgt, hog, priority)))
+    for name, fn in cases:
+        for hog in (False, True):
+            s = fn(seconds, target, hog)
+            label = f"{name}, {'busy UI' if hog else 'idle UI'}"
+            print(DeadlineScheduler.format_stats(f"{label:<26}", s) if s else f"{label}: no stats")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,140 @@
+"""
+Per-tick cost of the packet build + send path, before and after the in-place packing.
+
+    python3 bench_packet.py [ticks]
+
+"legacy" replays the previous path (mapping dict rebuilt and walked, state
+dict, struct.pack() with the format string, sendto() with the host tuple);
+"current" is UDPFormatter.pack_state() (copy of the record the reader
+published, already packed) into the reusable buffer and a send on the
+socket, unconnected (sendto() with the pre-resolved address) and connected;
+the reader-side ControllerState.publish() is timed on its own. Datagrams go
+to a local socket nobody reads. "peak B" is the largest amount of memory a
+single tick holds at once (tracemalloc): the transient dict, bytes and
+address objects of the legacy path.
+"""
+import socket
+import struct
+import sys
+import time
+import tracemalloc
+
+from controller_state import ControllerState
+from formatter import UDPFormatter
+from logger import Logger
+from settings import UDP_PACKET_FORMAT
+
+
+def legacy_udp_state(s: ControllerState) -> dict:
+    """ControllerState.get_udp_state() as it was."""
+    buttons_bitmask = 0
+    udp_mapping = {"X": 0, "Y": 1, "A": 2, "B": 3, "LB": 4, "RB": 5,
+                   "Share": 6, "Select": 7, "Xbox": 8, "LS": 13, "RS": 14}
+    for button, bit in udp_mapping.items():
+        if s.buttons.get(button, False):
+            buttons_bitmask |= (1 << bit)
+    if s.dpad_direction == 0:
+        buttons_bitmask |= (1 << 9)
+    elif s.dpad_direction == 1:
+        buttons_bitmask |= (1 << 11)
+    elif s.dpad_direction == 2:
+        buttons_bitmask |= (1 << 12)
+    elif s.dpad_direction == 3:
+        buttons_bitmask |= (1 << 10)
+    return {
+        "buttons": buttons_bitmask,
+        "left_stick_x": s.left_stick_x,
+        "left_stick_y": s.left_stick_y,
+        "right_stick_x": s.right_stick_x,
+        "right_stick_y": s.right_stick_y,
+        "left_trigger": s.left_trigger,
+        "right_trigger": s.right_trigger,
+    }
+
+
+def make_legacy(state, sock, target):
+    fmt = UDP_PACKET_FORMAT["struct"]
+
+    def tick():
+        d = legacy_udp_state(state)
+        packet = struct.pack(fmt, d["buttons"], d["left_stick_x"], d["left_stick_y"],
+                             d["right_stick_x"], d["right_stick_y"],
+                             d["left_trigger"], d["right_trigger"])
+        if len(packet) != 28:
+            pass
+        sock.sendto(packet, target)
+    return tick
+
+
+def make_current(state, formatter, sock, target):
+    def tick():
+        sock.sendto(formatter.pack_state(state), target)
+    return tick
+
+
+def make_connected(state, formatter, sock):
+    def tick():
+        sock.send(formatter.pack_state(state))
+    return tick
+
+
+def measure(tick, ticks: int):
+    for _ in range(1000):
+        tick()
+    t = time.perf_counter()
+    for _ in range(ticks):
+        tick()
+    ns = (time.perf_counter() - t) / ticks * 1e9
+
+    tracemalloc.start()
+    tick()
+    peak = 0
+    for _ in range(100):
+        tracemalloc.reset_peak()
+        base = tracemalloc.get_traced_memory()[0]
+        tick()
+        peak = max(peak, tracemalloc.get_traced_memory()[1] - base)
+    tracemalloc.stop()
+    return ns, peak
+
+
+def main():
+    ticks = int(sys.argv[1]) if len(sys.argv) > 1 else 200000
+    logger = Logger(enable_console=False)
+    state = ControllerState()
+    state.update_connection(True)
+    state.update_sticks(0.25, -0.5, 0.75, 0.1)
+    state.update_triggers(-1.0, 0.3)
+    state.update_button("A", True)
+    state.update_dpad(1)
+    state.publish()
+    formatter = UDPFormatter(logger)
+
+    sink = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sink.bind(("127.0.0.1", 0))
+    numeric_target = sink.getsockname()
+    host_target = (str(numeric_target[0]), numeric_target[1])   # like (ESP32_HOST, ESP32_PORT)
+
+    assert struct.pack(UDP_PACKET_FORMAT["struct"], *legacy_udp_state(state).values()) \
+        == formatter.format_packet(state), "packets differ"
+
+    tx = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    ctx = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    ctx.connect(numeric_target)
+    cases = [
+        ("legacy (dict + pack + sendto host)", make_legacy(state, tx, host_target)),
+        ("current, sendto resolved address", make_current(state, formatter, tx, numeric_target)),
+        ("current, connected socket", make_connected(state, formatter, ctx)),
+        ("legacy build only (no send)", lambda: struct.pack(UDP_PACKET_FORMAT["struct"],
+                                                            *legacy_udp_state(state).values())),
+        ("current build only (no send)", lambda: formatter.pack_state(state)),
+        ("publish, reader side (per change)", state.publish),
+    ]
+    print(f"{ticks} ticks per case")
+    for name, tick in cases:
+        ns, peak = measure(tick, ticks)
+        print(f"  {name:<36} {ns / 1000:7.2f} us/tick  peak {peak:4d} B")
+
+
+if __name__ == "__main__":
+    main()
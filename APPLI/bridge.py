@@ -3,6 +3,12 @@ from PyQt5.QtCore import QObject, pyqtSignal, pyqtSlot
 class Bridge(QObject):
     startRequested = pyqtSignal()
     stopRequested  = pyqtSignal()
+    resyncRequested = pyqtSignal()
+
+    # PY -> JS over the WebChannel: changed UI fields, at most once per UI frame
+    stateChanged = pyqtSignal('QVariantMap')
+    # PY -> JS: log records gathered during the last UI frame, as [level, text] pairs
+    logBatch = pyqtSignal('QVariantList')
 
     def __init__(self, logger, parent=None):
         super().__init__(parent)
@@ -18,6 +24,11 @@ class Bridge(QObject):
         self.logger.info("Stop requested")
         self.stopRequested.emit()
 
+    @pyqtSlot()
+    def request_state(self):
+        """JS just subscribed to stateChanged: next frame carries every field."""
+        self.resyncRequested.emit()
+
     @pyqtSlot(str)
     def debugPing(self, msg):
         self.logger.info(f"JS->PY ping: {msg}")
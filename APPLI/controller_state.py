@@ -1,6 +1,14 @@
 from dataclasses import dataclass, field
 from typing import Dict, Any, Optional
 from logger import Logger
+from seqlock import SeqlockBlock
+from settings import UDP_PACKET_FORMAT
+
+# Bits of the UDP buttons field, as sent on the wire
+UDP_BUTTON_MASKS = {"X": 1 << 0, "Y": 1 << 1, "A": 1 << 2, "B": 1 << 3, "LB": 1 << 4, "RB": 1 << 5,
+                    "Share": 1 << 6, "Select": 1 << 7, "Xbox": 1 << 8, "LS": 1 << 13, "RS": 1 << 14}
+UDP_DPAD_MASKS = {0: 1 << 9, 1: 1 << 11, 2: 1 << 12, 3: 1 << 10}   # Up, Right, Down, Left
+UDP_DPAD_ALL = (1 << 9) | (1 << 10) | (1 << 11) | (1 << 12)
 
 
 @dataclass
@@ -21,6 +29,15 @@ class ControllerState:
     
     # Connection state
     connected: bool = False
+
+    # UDP buttons field, kept up to date by update_button / update_dpad
+    udp_buttons: int = field(default=0, init=False)
+
+    # Bumped on every actual change: consumers skip work while it stays put
+    revision: int = field(default=0, init=False)
+
+    # Last published wire record, for readers on other threads (see publish())
+    _published: SeqlockBlock = field(default=None, init=False, repr=False)
     
     # Logger (optional)
     _logger: Optional[Logger] = field(default=None, init=False)
@@ -31,6 +48,13 @@ class ControllerState:
         for button in expected_buttons:
             if button not in self.buttons:
                 self.buttons[button] = False
+        for button, pressed in self.buttons.items():
+            if pressed:
+                self.udp_buttons |= UDP_BUTTON_MASKS.get(button, 0)
+        self.udp_buttons |= UDP_DPAD_MASKS.get(self.dpad_direction, 0)
+        self._published = SeqlockBlock(bytearray(SeqlockBlock.size_for(UDP_PACKET_FORMAT["struct"])),
+                                       UDP_PACKET_FORMAT["struct"])
+        self.publish()
     
     def set_logger(self, logger: Logger):
         """Set logger for state changes."""
@@ -40,6 +64,7 @@ class ControllerState:
         """Update connection status."""
         if self.connected != connected:
             self.connected = connected
+            self.revision += 1
             if self._logger:
                 if connected:
                     self._logger.success("Controller connected")
@@ -50,28 +75,47 @@ class ControllerState:
     def update_sticks(self, left_x=None, left_y=None, right_x=None, right_y=None):
         """Update stick positions."""
         if left_x is not None:
-            self.left_stick_x = max(-1.0, min(1.0, left_x))
+            self._set_axis("left_stick_x", left_x)
         if left_y is not None:
-            self.left_stick_y = max(-1.0, min(1.0, left_y))
+            self._set_axis("left_stick_y", left_y)
         if right_x is not None:
-            self.right_stick_x = max(-1.0, min(1.0, right_x))
+            self._set_axis("right_stick_x", right_x)
         if right_y is not None:
-            self.right_stick_y = max(-1.0, min(1.0, right_y))
+            self._set_axis("right_stick_y", right_y)
     
     def update_triggers(self, left_trigger=None, right_trigger=None):
         """Update trigger values."""
         if left_trigger is not None:
-            self.left_trigger = max(-1.0, min(1.0, left_trigger))
+            self._set_axis("left_trigger", left_trigger)
         if right_trigger is not None:
-            self.right_trigger = max(-1.0, min(1.0, right_trigger))
+            self._set_axis("right_trigger", right_trigger)
+
+    def _set_axis(self, name: str, value: float):
+        """Clamp and store one analog input, counting a revision if it changed."""
+        value = max(-1.0, min(1.0, value))
+        if getattr(self, name) != value:
+            setattr(self, name, value)
+            self.revision += 1
     
     def update_button(self, button_name: str, pressed: bool):
         """Update button state."""
+        if self.buttons.get(button_name) == pressed:
+            return
         self.buttons[button_name] = pressed
+        self.revision += 1
+        mask = UDP_BUTTON_MASKS.get(button_name, 0)
+        if pressed:
+            self.udp_buttons |= mask
+        else:
+            self.udp_buttons &= ~mask
     
     def update_dpad(self, direction: int):
         """Update D-pad direction."""
+        if direction == self.dpad_direction:
+            return
         self.dpad_direction = direction
+        self.revision += 1
+        self.udp_buttons = (self.udp_buttons & ~UDP_DPAD_ALL) | UDP_DPAD_MASKS.get(direction, 0)
     
     def get_ui_state(self) -> Dict[str, Any]:
         """Get state for UI display."""
@@ -97,29 +141,9 @@ class ControllerState:
         }
     
     def get_udp_state(self) -> Dict[str, Any]:
-        """Get state for UDP transmission."""
-        # Convert buttons to UDP bitmask
-        buttons_bitmask = 0
-        udp_mapping = {"X": 0, "Y": 1, "A": 2, "B": 3, "LB": 4, "RB": 5,
-                      "Share": 6, "Select": 7, "Xbox": 8, "LS": 13, "RS": 14}
-        
-        # Regular buttons
-        for button, bit in udp_mapping.items():
-            if self.buttons.get(button, False):
-                buttons_bitmask |= (1 << bit)
-        
-        # D-pad buttons
-        if self.dpad_direction == 0:    # Up
-            buttons_bitmask |= (1 << 9)
-        elif self.dpad_direction == 1:  # Right
-            buttons_bitmask |= (1 << 11)
-        elif self.dpad_direction == 2:  # Down
-            buttons_bitmask |= (1 << 12)
-        elif self.dpad_direction == 3:  # Left
-            buttons_bitmask |= (1 << 10)
-        
+        """Get state for UDP transmission (the send path packs the fields directly)."""
         return {
-            "buttons": buttons_bitmask,
+            "buttons": self.udp_buttons,
             "left_stick_x": self.left_stick_x,
             "left_stick_y": self.left_stick_y,
             "right_stick_x": self.right_stick_x,
@@ -128,6 +152,40 @@ class ControllerState:
             "right_trigger": self.right_trigger
         }
     
+    def publish(self):
+        """
+        Publish the current wire fields as one consistent record.
+
+        The writer (GamepadReader, replay) updates fields one at a time, so a
+        reader on another thread looking at them directly can mix two polls,
+        e.g. lx from one and ly from the next. The writer calls this once its
+        poll is complete; readers take snapshot_into(), which never blocks it.
+        """
+        self._published.write(self.udp_buttons,
+                              self.left_stick_x, self.left_stick_y,
+                              self.right_stick_x, self.right_stick_y,
+                              self.left_trigger, self.right_trigger)
+
+    def snapshot_into(self, dest) -> Optional[int]:
+        """
+        Copy the last published record, packed in UDP_PACKET_FORMAT, into dest.
+
+        Returns:
+            Its sequence number, or None if no consistent copy could be made
+            (dest is then unspecified)
+        """
+        return self._published.read_into(dest)
+
+    def apply_udp_state(self, buttons: int, left_x: float, left_y: float,
+                        right_x: float, right_y: float, left_trigger: float, right_trigger: float):
+        """Set the wire fields directly (session replay, no gamepad behind this state)."""
+        if buttons != self.udp_buttons:
+            self.udp_buttons = buttons
+            self.revision += 1
+        self.update_sticks(left_x, left_y, right_x, right_y)
+        self.update_triggers(left_trigger, right_trigger)
+        self.publish()
+    
     def _reset_inputs(self):
         """Reset all inputs to neutral."""
         self.left_stick_x = self.left_stick_y = 0.0
@@ -135,4 +193,6 @@ class ControllerState:
         self.left_trigger = self.right_trigger = -1.0
         self.dpad_direction = -1
         for button in self.buttons:
-            self.buttons[button] = False
\ No newline at end of file
+            self.buttons[button] = False
+        self.udp_buttons = 0
+        self.revision += 1
\ No newline at end of file
@@ -12,14 +12,40 @@ class UDPFormatter:
         self.logger = logger
         self._struct_format = UDP_PACKET_FORMAT["struct"]
         self._packet_size = UDP_PACKET_FORMAT["size"]
+        # Compiled once; every tick packs into the same buffer
+        self._packer = struct.Struct(self._struct_format)
+        self._buffer = bytearray(self._packer.size)
         
         # Validate struct format
-        expected_size = struct.calcsize(self._struct_format)
+        expected_size = self._packer.size
         if expected_size != self._packet_size:
             self.logger.failure(f"Struct size mismatch: expected {self._packet_size}, got {expected_size}")
         else:
             self.logger.success(f"UDP formatter initialized (packet size: {self._packet_size} bytes)")
     
+    def pack_state(self, controller_state: ControllerState) -> bytearray:
+        """
+        Copy the state's last published record into the reusable packet buffer
+        (send hot path).
+
+        The record is already packed in the wire format (<I6f) by the writer's
+        ControllerState.publish(), and copied under its seqlock: every field
+        comes from the same poll, even with the reader on another thread. No
+        intermediate dict and no new bytes object. The buffer is overwritten
+        on the next call, so send (or copy) it before then.
+
+        Args:
+            controller_state: Current controller state
+
+        Returns:
+            The 28-byte packet buffer
+        """
+        if controller_state.snapshot_into(self._buffer) is None:
+            # Writer held the record for every retry: send neutral rather than a mix
+            self.logger.failure("Controller snapshot busy, sending a neutral packet")
+            self._packer.pack_into(self._buffer, 0, 0, 0.0, 0.0, 0.0, 0.0, -1.0, -1.0)
+        return self._buffer
+
     def format_packet(self, controller_state: ControllerState) -> bytes:
         """
         Format controller state into UDP packet.
@@ -28,33 +54,9 @@ class UDPFormatter:
             controller_state: Current controller state
             
         Returns:
-            28-byte UDP packet as bytes
+            28-byte UDP packet as bytes (a copy, safe to keep)
         """
-        try:
-            # Get UDP state data
-            state_data = controller_state.get_udp_state()
-            
-            # Pack into binary format: <I6f (uint32 + 6 float32)
-            packet = struct.pack(
-                self._struct_format,
-                state_data["buttons"],          # uint32
-                state_data["left_stick_x"],     # float32
-                state_data["left_stick_y"],     # float32  
-                state_data["right_stick_x"],    # float32
-                state_data["right_stick_y"],    # float32
-                state_data["left_trigger"],     # float32
-                state_data["right_trigger"]     # float32
-            )
-            
-            return packet
-            
-        except Exception as e:
-            self.logger.failure(f"Failed to format UDP packet: {e}")
-            return self._create_empty_packet()
-    
-    def _create_empty_packet(self) -> bytes:
-        """Create an empty/neutral UDP packet."""
-        return struct.pack(self._struct_format, 0, 0.0, 0.0, 0.0, 0.0, -1.0, -1.0)
+        return bytes(self.pack_state(controller_state))
         
     def debug_packet(self, packet: bytes) -> str:
         """
@@ -69,7 +71,7 @@ class UDPFormatter:
         try:
             if len(packet) != self._packet_size:
                 return f"Invalid packet size: {len(packet)} (expected {self._packet_size})"
-            buttons, lx, ly, rx, ry, lt, rt = struct.unpack(self._struct_format, packet)
+            buttons, lx, ly, rx, ry, lt, rt = self._packer.unpack(packet)
             pressed = [BIT_TO_NAME[b] for b in range(32) if (buttons >> b) & 1 and b in BIT_TO_NAME]
             return (f"Buttons(mask=0x{buttons:08X}): {pressed}, "
                     f"L=({lx:.2f},{ly:.2f}), R=({rx:.2f},{ry:.2f}), Trig=({lt:.2f},{rt:.2f})")
@@ -1,9 +1,18 @@
-import pygame
+import os
 import time
+
+# Joystick only: no window, no focus needed for input, no import banner
+os.environ.setdefault("SDL_VIDEODRIVER", "dummy")
+os.environ.setdefault("SDL_JOYSTICK_ALLOW_BACKGROUND_EVENTS", "1")
+os.environ.setdefault("PYGAME_HIDE_SUPPORT_PROMPT", "1")
+
+import pygame
 from PyQt5.QtCore import QThread, pyqtSignal
 from controller_state import ControllerState
+from input_filter import InputConditioner
 from logger import Logger
-from settings import PYGAME_BUTTON_MAPPING, DPAD_MAPPING, POLL_HZ
+from scheduler import DeadlineScheduler
+from settings import PYGAME_BUTTON_MAPPING, DPAD_MAPPING, POLL_HZ, SCHED_REPORT_S
 
 
 class GamepadReader(QThread):
@@ -11,7 +20,7 @@ class GamepadReader(QThread):
     
     # Signal emitted when controller state changes
     state_changed = pyqtSignal(dict)  # Emits UI state dict
-    connection_changed = pyqtSignal(bool)  # Emits True/False on connect/disconnect
+    connection_changed = pyqtSignal(bool)  # Emitted by run() on transitions only
     
     def __init__(self, controller_state: ControllerState, logger: Logger):
         super().__init__()
@@ -19,16 +28,30 @@ class GamepadReader(QThread):
         self.logger = logger
         self.running = False
         self._joystick = None
-        self._poll_interval = 1.0 / POLL_HZ  # Convert Hz to seconds
+        self._scheduler = DeadlineScheduler(POLL_HZ)
+        self._conditioner = InputConditioner()  # Deadzone + hysteresis quantization
         
         # Initialize pygame
         self._init_pygame()
     
+    @staticmethod
+    def _init_subsystems():
+        """
+        Initialize only what joystick polling needs.
+
+        pygame.init() would also open the audio device and the other modules,
+        which costs most of the start-up time. The event pump that refreshes
+        joystick state needs the video subsystem, on the dummy driver.
+        """
+        if not pygame.display.get_init():
+            pygame.display.init()
+        if not pygame.joystick.get_init():
+            pygame.joystick.init()
+
     def _init_pygame(self):
         """Initialize pygame joystick module."""
         try:
-            pygame.init()
-            pygame.joystick.init()
+            self._init_subsystems()
             self.logger.success("Pygame initialized")
         except Exception as e:
             self.logger.failure(f"Failed to initialize pygame: {e}")
@@ -50,44 +73,82 @@ class GamepadReader(QThread):
     
     def run(self):
         """Main thread loop - reads gamepad and updates state."""
-        try:
-            if not pygame.get_init():
-                pygame.init()
-            if not pygame.joystick.get_init():
-                pygame.joystick.init()
-            self.logger.success("Pygame initialized")
-        except Exception as e:
-            self.logger.failure(f"Pygame init failed: {e}")
+        if not self.ensure_pygame():
             return
 
         self.running = True
         self.logger.info("Gamepad reader started")
+        self._scheduler.reset()
+        self._scheduler.stats()
+        next_report = time.monotonic() + SCHED_REPORT_S
+        connected = None
         
         while self.running:
             try:
-                pygame.event.pump() 
-                # Check for controller connection
-                self._check_connection()
-                self.connection_changed.emit(self.controller_state.connected)
-                
-                # Read inputs if connected
-                if self._joystick and self.controller_state.connected:
-                    self._read_inputs()
-                    
-                    # Emit state change signal
+                if self.poll_once():
+                    # Emit state change signal (only when an input actually moved)
                     ui_state = self.controller_state.get_ui_state()
                     self.state_changed.emit(ui_state)
-                
-                # Sleep to maintain polling rate
-                time.sleep(self._poll_interval)
+                # Connection status on transitions only
+                if self.controller_state.connected != connected:
+                    connected = self.controller_state.connected
+                    self.connection_changed.emit(connected)
+
+                if time.monotonic() >= next_report:
+                    stats = self._scheduler.stats()
+                    self.logger.info(DeadlineScheduler.format_stats("Gamepad reader", stats))
+                    next_report += SCHED_REPORT_S
+
+                # Wait for the next absolute deadline to maintain polling rate
+                self._scheduler.wait()
                 
             except Exception as e:
                 self.logger.failure(f"Error in gamepad reader: {e}")
                 time.sleep(0.1)  # Brief pause before retry
+                self._scheduler.reset()
         
         # Cleanup
         self._disconnect_controller()
+        if connected:
+            self.connection_changed.emit(False)
         self.logger.info("Gamepad reader thread finished")
+
+    def ensure_pygame(self) -> bool:
+        """(Re)initialize pygame from the thread that is going to poll."""
+        try:
+            self._init_subsystems()
+            return True
+        except Exception as e:
+            self.logger.failure(f"Pygame init failed: {e}")
+            return False
+
+    def poll_once(self) -> bool:
+        """
+        One polling iteration: handle (dis)connection, read all inputs, then
+        publish the state if anything changed (ControllerState.publish()).
+
+        Returns:
+            True if the connected controller's state changed (conditioned
+            inputs only move past noise, so an idle controller returns False)
+        """
+        revision = self.controller_state.revision
+        pygame.event.pump()
+        # Check for controller connection
+        self._check_connection()
+
+        # Read inputs if connected
+        if self._joystick and self.controller_state.connected:
+            self._read_inputs()
+
+        # Whole poll visible at once to the sender thread
+        if self.controller_state.revision != revision:
+            self.controller_state.publish()
+            return self.controller_state.connected
+        return False
+
+    def release(self):
+        """Release the controller (loop owner is stopping)."""
+        self._disconnect_controller()
     
     def _check_connection(self):
         """Check for controller connection/disconnection."""   
@@ -99,9 +160,9 @@ class GamepadReader(QThread):
             try:
                 self._joystick = pygame.joystick.Joystick(0)
                 self._joystick.init()
+                self._conditioner.reset()
                 self.controller_state.update_connection(True)
                 self.logger.success(f"Controller connected: {self._joystick.get_name()}")
-                self.connection_changed.emit(True)
             except Exception as e:
                 self.logger.failure(f"Failed to initialize controller: {e}")
                 self._joystick = None
@@ -120,7 +181,7 @@ class GamepadReader(QThread):
             self._joystick = None
         
         self.controller_state.update_connection(False)
-        self.connection_changed.emit(False)
+        self.controller_state.publish()
     
     def _read_inputs(self):
         """Read all controller inputs and update state."""
@@ -163,12 +224,14 @@ class GamepadReader(QThread):
         if 0 < num_axes:  # Left stick X
             left_x = self._joystick.get_axis(0)
             left_y = -self._joystick.get_axis(1) if 1 < num_axes else 0.0  # Invert Y
+            left_x, left_y = self._conditioner.stick("left", left_x, left_y)
             self.controller_state.update_sticks(left_x=left_x, left_y=left_y)
         
         # Right stick
         if 3 < num_axes:  # Right stick X
             right_x = self._joystick.get_axis(3)
             right_y = -self._joystick.get_axis(4) if 4 < num_axes else 0.0  # Invert Y
+            right_x, right_y = self._conditioner.stick("right", right_x, right_y)
             self.controller_state.update_sticks(right_x=right_x, right_y=right_y)
     
     def _read_triggers(self):
@@ -189,7 +252,8 @@ class GamepadReader(QThread):
         else:
             left_trigger = right_trigger = -1.0
         
-        self.controller_state.update_triggers(left_trigger, right_trigger)
+        self.controller_state.update_triggers(self._conditioner.trigger("left", left_trigger),
+                                              self._conditioner.trigger("right", right_trigger))
     
     def _read_dpad(self):
         """Read D-pad state."""
@@ -0,0 +1,115 @@
+import time
+from typing import Optional
+
+from controller_state import ControllerState
+from gamepad_reader import GamepadReader
+from impairment import NetworkImpairment
+from logger import Logger
+from pipeline import FusedPipeline
+from session import SessionRecorder
+from settings import HEADLESS_STATS_S, TICK_HZ
+from udp_sender import UDPSender
+
+
+class HeadlessRunner:
+    """
+    Reader + sender without the window, for a fast start or a machine with no display.
+
+    Only PyQt5.QtCore is loaded (signals and QThread): no QApplication, no
+    QtWebEngine page. The fused loop (pipeline.FusedPipeline) runs on its own
+    thread and this one prints a stats line every HEADLESS_STATS_S.
+    """
+
+    def __init__(self, t0: float, host: Optional[str] = None, port: Optional[int] = None,
+                 record: Optional[str] = None, impair: Optional[str] = None):
+        """
+        Args:
+            t0: perf_counter() at process start, for the time-to-first-packet line
+            host: ESP32 address overriding settings.ESP32_HOST
+            port: ESP32 port overriding settings.ESP32_PORT
+            record: Session file to record the controller into (replay.py)
+            impair: Network impairment spec (impairment.NetworkImpairment.parse_spec)
+        """
+        self.t0 = t0
+        self.logger = Logger(component_name="headless")
+        self.controller_state = ControllerState()
+        self.controller_state.set_logger(self.logger)
+        self.reader = GamepadReader(self.controller_state, self.logger)
+        self.sender = UDPSender(self.controller_state, self.logger)
+        if host or port:
+            self.sender.target_address = (host or self.sender.target_address[0],
+                                          port or self.sender.target_address[1])
+            self.logger.info(f"UDP target overridden: {self.sender.target_address}")
+        if impair:
+            self.sender.impairment = NetworkImpairment(NetworkImpairment.parse_spec(impair))
+        self.pipeline = FusedPipeline(self.reader, self.sender, self.logger)
+        if record:
+            self.pipeline.recorder = SessionRecorder(record, TICK_HZ)
+            self.logger.info(f"Recording session to {record}")
+
+        self._telemetry = None
+        # Direct call from the loop thread (no event loop here): just keep the latest
+        self.sender.telemetry_received.connect(self._on_telemetry)
+
+    def _on_telemetry(self, telemetry: dict):
+        self._telemetry = telemetry
+
+    def run(self, duration: float = 0.0) -> int:
+        """
+        Run until Ctrl+C, or for duration seconds if > 0.
+
+        Returns:
+            Process exit code
+        """
+        self.pipeline.start_pipeline()
+        first_logged = False
+        last_count = 0
+        last_t = time.perf_counter()
+        end = last_t + duration if duration > 0 else None
+
+        try:
+            while self.pipeline.isRunning():
+                time.sleep(0.01 if not first_logged else HEADLESS_STATS_S)
+                now = time.perf_counter()
+
+                if not first_logged and self.sender.first_send_at is not None:
+                    first_logged = True
+                    ms = (self.sender.first_send_at - self.t0) * 1000
+                    self.logger.success(f"First UDP packet {ms:.0f} ms after start")
+                    last_count, last_t = self.sender.sent_count, now
+                elif first_logged:
+                    count = self.sender.sent_count
+                    self.logger.info(self._format_stats(count - last_count, now - last_t))
+                    last_count, last_t = count, now
+
+                if end is not None and now >= end:
+                    break
+        except KeyboardInterrupt:
+            print()
+        finally:
+            self.pipeline.stop_pipeline()
+            if self.pipeline.recorder:
+                self.pipeline.recorder.close()
+                self.logger.success(f"Session saved: {self.pipeline.recorder.count} records "
+                                    f"in {self.pipeline.recorder.path}")
+
+        return 0 if self.sender.sent_count else 1
+
+    def _format_stats(self, sent: int, elapsed: float) -> str:
+        """One stats line: send rate, controller, loop jitter, ESP32 telemetry."""
+        parts = [f"sent {self.sender.sent_count} ({sent / elapsed:.0f} Hz)",
+                 "pad " + ("on" if self.controller_state.connected else "off")]
+        ticks = self.sender.tick_stats
+        if ticks:
+            parts.append(f"late p99<={ticks['p99_us']} us overruns={ticks['overruns']}")
+        t = self._telemetry
+        if t:
+            rssi = f"{t['rssi']} dBm" if t["rssi"] is not None else "n/a"
+            parts.append(f"esp rx={t['rx_frames']} drops={t['drops']} rssi={rssi}")
+        else:
+            parts.append("esp no telemetry")
+        if self.sender.impairment:
+            s = self.sender.impairment.stats()
+            parts.append(f"impair lost={s['lost_random'] + s['lost_burst']} "
+                         f"dup={s['duplicated']} reord={s['reordered']}")
+        return " | ".join(parts)
@@ -0,0 +1,177 @@
+import heapq
+import random
+import threading
+import time
+from typing import Callable, Dict, Optional
+
+from settings import NET_IMPAIRMENT
+
+
+class NetworkImpairment:
+    """
+    Emulates a bad link between UDPFormatter and the socket.
+
+    Every packet goes through, in order: random loss, bursty loss
+    (Gilbert-Elliott: a "bad" state entered with probability burst_enter per
+    packet, left with burst_exit, dropping with burst_loss while in it),
+    duplication, then a delay of delay_ms +/- jitter_ms (uniform) that keeps
+    packets in order, except those picked for reordering, which are held
+    reorder_ms longer and get overtaken. All decisions come from one RNG
+    seeded with seed, so the same packet sequence gets the same fate on
+    every run; only the wall-clock delivery times vary.
+
+    Delayed packets are sent by a delivery thread; with no delay at all a
+    packet is sent from the caller's thread.
+    """
+
+    def __init__(self, config: Optional[Dict] = None):
+        self.config = dict(NET_IMPAIRMENT, **(config or {}))
+        c = self.config
+        self._rng = random.Random(c["seed"])
+        self._bad = False
+        self._send: Optional[Callable[[bytes], None]] = None
+
+        self._heap = []               # (release perf_counter, seq, packet)
+        self._seq = 0
+        self._last_release = 0.0      # FIFO floor for in-order packets
+        self._cond = threading.Condition()
+        self._thread: Optional[threading.Thread] = None
+        self._running = False
+
+        self.counters = {"submitted": 0, "sent": 0, "lost_random": 0, "lost_burst": 0,
+                         "duplicated": 0, "reordered": 0, "send_errors": 0}
+
+    @staticmethod
+    def parse_spec(spec: str) -> Dict:
+        """
+        Parse a command-line spec, e.g. "loss=0.02,burst_enter=0.01,delay_ms=5,seed=3".
+
+        Raises:
+            ValueError: unknown key or bad number
+        """
+        config = {}
+        for item in filter(None, (part.strip() for part in spec.split(","))):
+            key, _, value = item.partition("=")
+            key = key.strip()
+            if key not in NET_IMPAIRMENT or key == "enabled":
+                raise ValueError(f"unknown impairment '{key}' "
+                                 f"(expected one of {', '.join(k for k in NET_IMPAIRMENT if k != 'enabled')})")
+            config[key] = int(value) if key == "seed" else float(value)
+        return config
+
+    def describe(self) -> str:
+        c = self.config
+        return (f"loss={c['loss']:g} burst={c['burst_enter']:g}/{c['burst_exit']:g}/{c['burst_loss']:g} "
+                f"delay={c['delay_ms']:g}+/-{c['jitter_ms']:g} ms dup={c['duplicate']:g} "
+                f"reorder={c['reorder']:g}(+{c['reorder_ms']:g} ms) seed={c['seed']}")
+
+    def start(self, send: Callable[[bytes], None]):
+        """Start delivering through send(packet) (the sender's socket)."""
+        self._send = send
+        self._running = True
+        self._thread = threading.Thread(target=self._deliver, name="net-impairment", daemon=True)
+        self._thread.start()
+
+    def stop(self):
+        """Stop the delivery thread; packets still in flight are dropped."""
+        with self._cond:
+            self._running = False
+            self._heap.clear()
+            self._cond.notify()
+        if self._thread:
+            self._thread.join(1.0)
+            self._thread = None
+
+    def drain(self, timeout: float = 1.0):
+        """Wait until every delayed packet has been sent (end of a replay)."""
+        end = time.perf_counter() + timeout
+        while time.perf_counter() < end:
+            with self._cond:
+                if not self._heap:
+                    return
+            time.sleep(0.001)
+
+    def submit(self, packet: bytes):
+        """Pass one packet through the emulated link (packet must not be reused by the caller)."""
+        c = self.config
+        rng = self._rng
+        self.counters["submitted"] += 1
+
+        if c["burst_enter"] > 0.0:
+            if self._bad:
+                self._bad = rng.random() >= c["burst_exit"]
+            else:
+                self._bad = rng.random() < c["burst_enter"]
+        if rng.random() < c["loss"]:
+            self.counters["lost_random"] += 1
+            return
+        if self._bad and rng.random() < c["burst_loss"]:
+            self.counters["lost_burst"] += 1
+            return
+
+        copies = 1
+        if rng.random() < c["duplicate"]:
+            copies = 2
+            self.counters["duplicated"] += 1
+        for _ in range(copies):
+            self._schedule(packet)
+
+    def _schedule(self, packet: bytes):
+        c = self.config
+        rng = self._rng
+        delay = c["delay_ms"] + (rng.uniform(-c["jitter_ms"], c["jitter_ms"]) if c["jitter_ms"] else 0.0)
+        reorder = rng.random() < c["reorder"]
+        if reorder:
+            self.counters["reordered"] += 1
+            delay += c["reorder_ms"]
+
+        now = time.perf_counter()
+        release = now + max(0.0, delay) / 1000.0
+        if not reorder:
+            # Jitter on a FIFO link: a packet never overtakes the previous one
+            release = max(release, self._last_release)
+            self._last_release = release
+
+        with self._cond:
+            if release <= now and not self._heap:
+                inline = True
+            else:
+                inline = False
+                heapq.heappush(self._heap, (release, self._seq, packet))
+                self._seq += 1
+                self._cond.notify()
+        if inline:
+            self._emit(packet)
+
+    def _deliver(self):
+        while True:
+            with self._cond:
+                while self._running and (not self._heap or self._heap[0][0] > time.perf_counter()):
+                    timeout = self._heap[0][0] - time.perf_counter() if self._heap else None
+                    self._cond.wait(timeout)
+                if not self._running:
+                    return
+                _release, _seq, packet = heapq.heappop(self._heap)
+            self._emit(packet)
+
+    def _emit(self, packet: bytes):
+        try:
+            self._send(packet)
+            self.counters["sent"] += 1
+        except OSError:
+            self.counters["send_errors"] += 1
+
+    def stats(self) -> Dict:
+        """Counters plus packets currently held in flight."""
+        with self._cond:
+            in_flight = len(self._heap)
+        return dict(self.counters, in_flight=in_flight)
+
+    @staticmethod
+    def format_stats(s: Dict) -> str:
+        """One log line for a stats() result."""
+        lost = s["lost_random"] + s["lost_burst"]
+        pct = 100.0 * lost / s["submitted"] if s["submitted"] else 0.0
+        return (f"impairment: {s['submitted']} in, {s['sent']} out, lost {lost} ({pct:.1f}%: "
+                f"random {s['lost_random']}, burst {s['lost_burst']}), dup {s['duplicated']}, "
+                f"reordered {s['reordered']}, in flight {s['in_flight']}, errors {s['send_errors']}")
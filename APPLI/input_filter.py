@@ -0,0 +1,74 @@
+import math
+from typing import Dict, Tuple
+
+from settings import DEADZONE, INPUT_HYSTERESIS, STICK_STEP, TRIGGER_DEADZONE, TRIGGER_STEP
+
+
+class InputConditioner:
+    """
+    Conditions raw joystick axes before they reach ControllerState.
+
+    Per stick: radial deadzone (DEADZONE on the vector length, the rest of the
+    travel rescaled to the full range). Per trigger: deadzone at the released
+    end. Then every axis is quantized to the step the car can resolve
+    (STICK_STEP, TRIGGER_STEP) with hysteresis: the output only moves once the
+    input has gone INPUT_HYSTERESIS past the rounding boundary, so
+    drift and ADC noise around a level leave the state untouched.
+    """
+
+    def __init__(self):
+        self._last: Dict[str, float] = {}
+
+    def reset(self):
+        """Forget the held levels (controller reconnected)."""
+        self._last.clear()
+
+    def stick(self, name: str, x: float, y: float) -> Tuple[float, float]:
+        """
+        Condition one stick.
+
+        Args:
+            name: Stick identifier ("left", "right"), keys the held levels
+            x, y: Raw axes in [-1, 1]
+
+        Returns:
+            Conditioned (x, y)
+        """
+        mag = math.hypot(x, y)
+        if mag <= DEADZONE:
+            x = y = 0.0
+        else:
+            scale = min(1.0, (mag - DEADZONE) / (1.0 - DEADZONE)) / mag
+            x *= scale
+            y *= scale
+        return (self._quantize(name + "_x", x, STICK_STEP),
+                self._quantize(name + "_y", y, STICK_STEP))
+
+    def trigger(self, name: str, value: float) -> float:
+        """
+        Condition one trigger.
+
+        Args:
+            name: Trigger identifier ("left", "right")
+            value: Raw axis, -1 released to 1 fully pressed
+
+        Returns:
+            Conditioned value in the same range
+        """
+        travel = (value + 1.0) * 0.5
+        if travel <= TRIGGER_DEADZONE:
+            travel = 0.0
+        else:
+            travel = min(1.0, (travel - TRIGGER_DEADZONE) / (1.0 - TRIGGER_DEADZONE))
+        return self._quantize(name + "_trigger", travel * 2.0 - 1.0, TRIGGER_STEP)
+
+    def _quantize(self, key: str, value: float, step: float) -> float:
+        """Snap to the step grid; keep the held level while within its hysteresis band."""
+        held = self._last.get(key)
+        # Rest (deadzone) and full scale are exact: always reached, never held off
+        if (held is not None and value not in (-1.0, 0.0, 1.0)
+                and abs(value - held) <= step * 0.5 + INPUT_HYSTERESIS):
+            return held
+        level = round(value / step) * step
+        self._last[key] = level
+        return level
@@ -17,6 +17,8 @@ class Logger(QObject):
     
     # Qt signal for UI integration - connects to HTML appendLog API
     logMessage = pyqtSignal(str)
+    # Same message with its level, for sinks that filter (UI log panel)
+    logRecord = pyqtSignal(str, str)  # (level, formatted message)
     
     def __init__(self, 
                  enable_console: bool = True, 
@@ -75,6 +77,7 @@ class Logger(QObject):
         
         # Emit Qt signal for UI (thread-safe)
         self.logMessage.emit(formatted_message)
+        self.logRecord.emit(level, formatted_message)
         
         # Console output if enabled
         if self.enable_console:
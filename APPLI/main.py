@@ -1,15 +1,51 @@
+import time
+_T0 = time.perf_counter()  # Process start, before the heavy imports
+
+import argparse
 import sys
-from PyQt5.QtWidgets import QApplication
-from PyQt5.QtCore import Qt
-from main_window import MainWindow
-from PyQt5.QtCore import QCoreApplication, Qt
+from settings import SCHED_SWITCH_INTERVAL_S
 
 
-def main():
-    """Main application entry point."""
+def parse_args():
+    """Command line: the window by default, --headless for the bare send loop."""
+    parser = argparse.ArgumentParser(description="VROOM VROOM controller to ESP32 UDP sender")
+    parser.add_argument("--headless", action="store_true",
+                        help="no window: joystick + UDP loop only, stats on the terminal")
+    parser.add_argument("--host", help="headless: ESP32 address (default: settings.ESP32_HOST)")
+    parser.add_argument("--port", type=int, help="headless: ESP32 UDP port (default: settings.ESP32_PORT)")
+    parser.add_argument("--record", metavar="FILE",
+                        help="headless: record the controller session (replay with replay.py)")
+    parser.add_argument("--impair", metavar="SPEC",
+                        help='headless: emulate a bad link, e.g. "loss=0.05,delay_ms=5,jitter_ms=3,seed=2"')
+    parser.add_argument("--duration", type=float, default=0.0,
+                        help="headless: stop after this many seconds (default: until Ctrl+C)")
+    args = parser.parse_args()
+    if args.impair:
+        from impairment import NetworkImpairment
+        try:
+            NetworkImpairment.parse_spec(args.impair)
+        except ValueError as e:
+            parser.error(str(e))
+    return args
+
+
+def run_headless(args) -> int:
+    """Headless mode: no Qt GUI modules are imported."""
+    from headless import HeadlessRunner
+    runner = HeadlessRunner(_T0, host=args.host, port=args.port, record=args.record,
+                            impair=args.impair)
+    return runner.run(args.duration)
+
+
+def run_gui():
+    """Window mode: QtWebEngine page + threads started from the UI."""
+    from PyQt5.QtWidgets import QApplication
+    from PyQt5.QtCore import QCoreApplication, Qt
+    from main_window import MainWindow
+
     QCoreApplication.setAttribute(Qt.AA_EnableHighDpiScaling, True)
     # Create QApplication
-    app = QApplication(sys.argv)
+    app = QApplication(sys.argv[:1])
     app.setApplicationName("VROOM VROOM PROJECT")
     app.setOrganizationName("VroomVroom")
     
@@ -30,5 +66,15 @@ def main():
         sys.exit(0)
 
 
+def main():
+    """Main application entry point."""
+    args = parse_args()
+    # Paced loops must get the GIL back within their spin window
+    sys.setswitchinterval(SCHED_SWITCH_INTERVAL_S)
+    if args.headless:
+        sys.exit(run_headless(args))
+    run_gui()
+
+
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main()
@@ -5,15 +5,17 @@ import json
 from PyQt5.QtWidgets import QMainWindow
 from PyQt5.QtWebEngineWidgets import QWebEngineView
 from PyQt5.QtWebChannel import QWebChannel
-from PyQt5.QtCore import pyqtSlot, QUrl, Qt
+from PyQt5.QtCore import QUrl, Qt
 
 # Local imports
 from logger import Logger
 from controller_state import ControllerState
 from gamepad_reader import GamepadReader
-from ui_bridge import UIBridge
+from ui_bridge import UIBridge, UILogSink, UIStateCoalescer
 from bridge import Bridge  # QObject exposed to the WebChannel (JS <-> Python)
-from settings import UI_CONFIG
+from pipeline import FusedPipeline
+from rt_process import RealtimeProcess
+from settings import PIPELINE_MODE, UI_CONFIG
 from udp_sender import UDPSender
 
 
@@ -31,9 +33,26 @@ class MainWindow(QMainWindow):
         self.controller_state.set_logger(self.logger)
 
         # Threads: gamepad reader (pygame) + UI cadence bridge + UDP sender
-        self.gamepad_reader = GamepadReader(self.controller_state, self.logger)
+        self.gamepad_reader = None
+        self.udp_sender = None
         self.ui_bridge = UIBridge(self.controller_state, self.logger)
-        self.udp_sender = UDPSender(self.controller_state, self.logger)
+
+        self.pipeline = None
+        if PIPELINE_MODE == "process":
+            # Same loop as fused mode in a worker process, which owns the gamepad
+            # and the socket: no pygame or sender here, this process only observes it
+            self.pipeline = RealtimeProcess(self.logger, parent=self)
+        else:
+            self.gamepad_reader = GamepadReader(self.controller_state, self.logger)
+            self.udp_sender = UDPSender(self.controller_state, self.logger)
+            if PIPELINE_MODE == "fused":
+                # One loop drives the reader and the sender (their threads stay idle)
+                self.pipeline = FusedPipeline(self.gamepad_reader, self.udp_sender, self.logger)
+
+        # Controller snapshots -> page, changed fields once per UI frame
+        self.ui_coalescer = UIStateCoalescer(self.logger, parent=self)
+        # Log records -> page log panel, batched per UI frame
+        self.ui_log_sink = UILogSink(parent=self)
 
         # Web channel pieces (created once page is loaded)
         self.web_view = None
@@ -70,11 +89,13 @@ class MainWindow(QMainWindow):
     def _connect_signals(self):
         """Connect all signal/slot connections."""
 
-        # Logger -> UI (append messages into the HTML console)
-        self.logger.logMessage.connect(self.ui_append_log)
+        # Logger -> UI (batched into the HTML log panel)
+        self.logger.logRecord.connect(self.ui_log_sink.append, Qt.QueuedConnection)
 
-        # GamepadReader -> (optional) direct UI push (can be kept for fast feedback)
-        self.gamepad_reader.connection_changed.connect(self._ui_set_controller_status, Qt.QueuedConnection)
+        # GamepadReader -> UI (split mode: its loop emits on transitions only)
+        if self.gamepad_reader:
+            self.gamepad_reader.connection_changed.connect(self._ui_set_controller_status,
+                                                           Qt.QueuedConnection)
 
         # UIBridge -> UI (status and periodic snapshots)
         self.ui_bridge.connection_changed.connect(self._ui_set_controller_status, Qt.QueuedConnection)
@@ -83,8 +104,21 @@ class MainWindow(QMainWindow):
         # Web page fully loaded
         self.web_view.loadFinished.connect(self._on_page_loaded)
 
+        # FusedPipeline -> UI (replaces reader/bridge pushes in fused mode)
+        if self.pipeline:
+            self.pipeline.connection_changed.connect(self._ui_set_controller_status, Qt.QueuedConnection)
+            self.pipeline.state_changed.connect(self._ui_push_state, Qt.QueuedConnection)
+
+        # RealtimeProcess -> UI (what the in-process sender reports in the other modes)
+        if isinstance(self.pipeline, RealtimeProcess):
+            self.pipeline.log_record.connect(self.ui_log_sink.append)
+            self.pipeline.telemetry_received.connect(self._ui_set_telemetry)
+            self.pipeline.udp_status_changed.connect(self._ui_set_udp_status)
+
         # UDP_sender -> UI
-        self.udp_sender.connection_status_changed.connect(self._ui_set_udp_status)
+        if self.udp_sender:
+            self.udp_sender.connection_status_changed.connect(self._ui_set_udp_status)
+            self.udp_sender.telemetry_received.connect(self._ui_set_telemetry, Qt.QueuedConnection)
 
     # -------------------------------------------------------------------------
     # Page loaded: inject config and build the WebChannel bridge
@@ -102,8 +136,8 @@ class MainWindow(QMainWindow):
 
         # Create QWebChannel and expose Python Bridge to JS (window.bridge)
         self._setup_webchannel()
-        self._ui_set_controller_status(self.controller_state.connected)  # push initial
-        self._ui_set_app_status("Running" if self.gamepad_reader.isRunning() else "Stopped")
+        self._ui_set_controller_status(self._controller_connected())  # push initial
+        self._ui_set_app_status("Running" if self._is_running() else "Stopped")
 
     def _inject_config(self):
         """Inject configuration into the HTML page."""
@@ -127,6 +161,9 @@ class MainWindow(QMainWindow):
             # JS -> PY
             self.bridge.startRequested.connect(self._on_start_clicked)
             self.bridge.stopRequested.connect(self._on_stop_clicked)
+            # PY -> JS state transport
+            self.ui_coalescer.attach(self.bridge)
+            self.ui_log_sink.attach(self.bridge)
 
         if not self.channel:
             self.channel = QWebChannel(self.web_view.page())
@@ -182,14 +219,8 @@ class MainWindow(QMainWindow):
         """)
 
     def _ui_push_state(self, state: dict):
-        """Push a full controller snapshot to the UI (axes, buttons, triggers)."""
-        payload = json.dumps(state)
-        self._ui_js(
-            f'(window.UI && window.UI.updateGamepad && window.UI.updateGamepad({payload})) || '
-            f'(window.UI && window.UI.updateControlState && window.UI.updateControlState({payload})) || '
-            f'(window.ui && window.ui.updateGamepad && window.ui.updateGamepad({payload})) || '
-            f'(window.ui && window.ui.updateControlState && window.ui.updateControlState({payload}));'
-        )
+        """Hand a controller snapshot to the coalescer (sent on the next UI frame)."""
+        self.ui_coalescer.offer(state)
 
     def _ui_set_udp_status(self, status: str):
         """Update visual status on UI"""
@@ -201,11 +232,34 @@ class MainWindow(QMainWindow):
         }})("{safe}");
         """)
 
+    def _ui_set_telemetry(self, telemetry: dict):
+        """Push the latest car-side link health to the UI."""
+        payload = json.dumps(telemetry)
+        self._ui_js(f"window.UI && window.UI.updateTelemetry && window.UI.updateTelemetry({payload});")
+
     # -------------------------------------------------------------------------
     # Start/Stop coming from JS (via Bridge)
     # -------------------------------------------------------------------------
+    def _controller_connected(self) -> bool:
+        """Last known controller status, from whoever owns the gamepad."""
+        if isinstance(self.pipeline, RealtimeProcess):
+            return self.pipeline.connected
+        return self.controller_state.connected
+
+    def _is_running(self) -> bool:
+        if self.pipeline:
+            return self.pipeline.isRunning()
+        return self.gamepad_reader.isRunning()
+
     def _on_start_clicked(self):
         """Start threads from UI action (idempotent)."""
+        if self.pipeline:
+            if not self.pipeline.isRunning():
+                self.pipeline.start_pipeline()
+            self.logger.success("Application started from UI")
+            self._ui_set_app_status("Running")
+            return
+
         # Start gamepad reader thread
         if not self.gamepad_reader.isRunning():
             self.gamepad_reader.start_reading()
@@ -224,9 +278,16 @@ class MainWindow(QMainWindow):
 
     def _on_stop_clicked(self):
         """Stop threads from UI action (idempotent)."""
+        # Stop fused loop
+        try:
+            if self.pipeline and self.pipeline.isRunning():
+                self.pipeline.stop_pipeline()
+        except Exception as e:
+            self.logger.failure(f"Stop pipeline error: {e}")
+
         # Stop reader
         try:
-            if self.gamepad_reader.isRunning():
+            if self.gamepad_reader and self.gamepad_reader.isRunning():
                 self.gamepad_reader.stop_reading()
                 self.gamepad_reader.wait(1000)
         except Exception as e:
@@ -241,7 +302,7 @@ class MainWindow(QMainWindow):
 
         # Stop sender
         try:
-            if self.udp_sender.isRunning():
+            if self.udp_sender and self.udp_sender.isRunning():
                 self.udp_sender.stop_sending()
         except Exception as e:
             self.logger.failure(f"Stop UDP error: {e}")
@@ -250,29 +311,17 @@ class MainWindow(QMainWindow):
         self.logger.info("Application stopped from UI")
         self._ui_set_app_status("Stopped")
 
-    # -------------------------------------------------------------------------
-    # Slots used by logger and legacy direct pushes
-    # -------------------------------------------------------------------------
-    @pyqtSlot(str)
-    def ui_append_log(self, message: str):
-        """Append message to the UI log console."""
-        # Escape for safe JS string literal
-        escaped = (
-            message.replace("\\", "\\\\")
-                   .replace("'", "\\'")
-                   .replace("\n", "\\n")
-        )
-        self._ui_js(f"if (window.UI) window.UI.appendLog('{escaped}');"
-                    f"if (window.ui) window.ui.appendLog && window.ui.appendLog('{escaped}');")
-
     # -------------------------------------------------------------------------
     # Programmatic start/stop (used on app open/close)
     # -------------------------------------------------------------------------
     def start_app(self):
         """Start the gamepad reading and UI updates."""
         try:
-            self.gamepad_reader.start_reading()
-            self.ui_bridge.start_bridge()
+            if self.pipeline:
+                self.pipeline.start_pipeline()
+            else:
+                self.gamepad_reader.start_reading()
+                self.ui_bridge.start_bridge()
             self.ui_set_app_state(True)
             self.logger.success("Application started")
         except Exception as e:
@@ -281,7 +330,10 @@ class MainWindow(QMainWindow):
     def stop_app(self):
         """Stop the gamepad reading and UI updates."""
         try:
-            self.gamepad_reader.stop_reading()
+            if self.pipeline:
+                self.pipeline.stop_pipeline()
+            if self.gamepad_reader:
+                self.gamepad_reader.stop_reading()
             self.ui_bridge.stop_bridge()
             self.ui_set_app_state(False)
             self.logger.success("Application stopped")
@@ -0,0 +1,111 @@
+import time
+from PyQt5.QtCore import QThread, pyqtSignal
+from gamepad_reader import GamepadReader
+from impairment import NetworkImpairment
+from logger import Logger
+from scheduler import DeadlineScheduler
+from settings import SCHED_REPORT_S, TICK_HZ, UI_HZ
+from udp_sender import UDPSender
+
+
+class FusedPipeline(QThread):
+    """
+    Single real-time loop: read the joystick and send the packet in the same tick.
+
+    In split mode GamepadReader (POLL_HZ) and UDPSender (TICK_HZ) each sample
+    the shared ControllerState on their own clock, so a fresh reading can wait
+    up to a full sender period and the two loops beat against each other. Here
+    the read happens right before the send, at TICK_HZ, and the UI receives a
+    copy of the state only every TICK_HZ / UI_HZ ticks.
+
+    The reader and sender objects are reused for their per-tick methods; their
+    own threads are not started in this mode.
+    """
+
+    # Same signals as the split-mode threads feeding the UI
+    state_changed = pyqtSignal(dict)       # Decimated UI state copy
+    connection_changed = pyqtSignal(bool)  # Emitted on change only
+    tick_stats_reported = pyqtSignal(dict) # Scheduler stats, every report_s
+
+    def __init__(self, reader: GamepadReader, sender: UDPSender, logger: Logger):
+        super().__init__()
+        self.reader = reader
+        self.sender = sender
+        self.logger = logger
+        self.running = False
+        self.scheduler = DeadlineScheduler(TICK_HZ)
+        self.recorder = None  # Optional session.SessionRecorder, fed after each send
+        self.report_s = SCHED_REPORT_S
+        self._ui_every = max(1, round(TICK_HZ / UI_HZ))
+
+        self.logger.info(f"Fused pipeline initialized (poll+send: {TICK_HZ}Hz, "
+                         f"UI: 1/{self._ui_every} ticks)")
+
+    def start_pipeline(self):
+        """Start the fused loop."""
+        if not self.running:
+            self.running = True
+            self.start()  # Start QThread
+            self.logger.info("Fused pipeline started")
+
+    def stop_pipeline(self):
+        """Stop the fused loop."""
+        self.running = False
+        if self.isRunning():
+            self.wait(2000)  # Wait up to 2 seconds
+        self.logger.info("Fused pipeline stopped")
+
+    def run(self):
+        """Poll, send, then wait for the next deadline."""
+        self.logger.info("Fused pipeline thread started")
+        if not self.reader.ensure_pygame():
+            return
+        if not self.sender.open():
+            return
+
+        state = self.reader.controller_state
+        connected = None
+        ui_revision = None
+        tick = 0
+        self.scheduler.reset()
+        self.scheduler.stats()
+        next_report = time.monotonic() + self.report_s
+
+        while self.running:
+            try:
+                self.reader.poll_once()
+                self.sender.send_state(tick)
+
+                # Off the input-to-wire path: UI copy and status after the send
+                if state.connected != connected:
+                    connected = state.connected
+                    self.connection_changed.emit(connected)
+                # Decimated, and skipped while the conditioned inputs sit still
+                if connected and tick % self._ui_every == 0 and state.revision != ui_revision:
+                    ui_revision = state.revision
+                    self.state_changed.emit(state.get_ui_state())
+                if self.recorder:
+                    self.recorder.sample(state)
+                tick += 1
+
+                if time.monotonic() >= next_report:
+                    self.sender.tick_stats = self.scheduler.stats()
+                    self.logger.info(DeadlineScheduler.format_stats("Fused pipeline",
+                                                                    self.sender.tick_stats))
+                    self.tick_stats_reported.emit(self.sender.tick_stats)
+                    if self.sender.impairment:
+                        self.logger.info(NetworkImpairment.format_stats(
+                            self.sender.impairment.stats()))
+                    next_report += self.report_s
+
+                self.scheduler.wait()
+            except Exception as e:
+                self.logger.failure(f"Error in fused pipeline: {e}")
+                time.sleep(0.1)
+                self.scheduler.reset()
+
+        self.sender.close()
+        self.reader.release()
+        if connected:
+            self.connection_changed.emit(False)
+        self.logger.info("Fused pipeline thread finished")
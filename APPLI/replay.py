@@ -0,0 +1,160 @@
+"""
+Replays a recorded or synthetic session into UDPSender, without a gamepad.
+
+    python3 replay.py session.vvr [--speed 4] [--loop N]
+    python3 replay.py --synth sweep|step|noise [--seconds 30] [--seed 1] [--out file.vvr]
+
+Packet n always carries the session state at n / TICK_HZ, whatever the
+speed: --speed only changes how fast the packets go out (TICK_HZ * speed).
+Two runs of the same file or of the same synthetic kind and seed send the
+same byte sequence; the digest printed at the end checks it.
+"""
+import argparse
+import hashlib
+import sys
+import time
+from typing import List
+
+from controller_state import ControllerState
+from impairment import NetworkImpairment
+from logger import Logger
+from scheduler import DeadlineScheduler
+from session import SYNTH_KINDS, Record, read_session, synth_session, write_session
+from settings import SCHED_REPORT_S, TICK_HZ
+from udp_sender import UDPSender
+
+
+class SessionPlayer:
+    """Sends a session through UDPSender on its own fixed-rate loop."""
+
+    def __init__(self, records: List[Record], sender: UDPSender, logger: Logger,
+                 speed: float = 1.0, loops: int = 1):
+        """
+        Args:
+            records: Session records (absolute µs from the session start)
+            sender: Sender whose controller_state the session drives
+            logger: Logger instance
+            speed: Send rate multiplier (packet contents do not depend on it)
+            loops: Times to play the session, 0 = until Ctrl+C
+        """
+        self.records = records
+        self.sender = sender
+        self.logger = logger
+        self.speed = speed
+        self.loops = loops
+        self.running = False
+        self.scheduler = DeadlineScheduler(TICK_HZ * speed)
+        self.digest = hashlib.sha256()
+
+    def _session_ticks(self) -> int:
+        """Ticks in one pass: up to the last record, plus one to send it."""
+        last_us = self.records[-1][0] if self.records else 0
+        return last_us * TICK_HZ // 1_000_000 + 1
+
+    def run(self) -> int:
+        """
+        Play the session.
+
+        Returns:
+            Number of packets sent
+        """
+        state: ControllerState = self.sender.controller_state
+        state.update_connection(True)
+        if not self.sender.open():
+            return 0
+
+        per_pass = self._session_ticks()
+        tick = 0
+        idx = 0
+        self.running = True
+        self.scheduler.reset()
+        self.scheduler.stats()
+        next_report = time.monotonic() + SCHED_REPORT_S
+        start = time.perf_counter()
+
+        try:
+            while self.running and (self.loops == 0 or tick < per_pass * self.loops):
+                n = tick % per_pass
+                if n == 0:
+                    idx = 0
+                # Every record due by this tick, on the session clock
+                due_us = n * 1_000_000 // TICK_HZ
+                while idx < len(self.records) and self.records[idx][0] <= due_us:
+                    state.apply_udp_state(*self.records[idx][1:])
+                    idx += 1
+
+                self.sender.send_state(tick)
+                self.digest.update(self.sender.formatter.pack_state(state))
+                tick += 1
+
+                if time.monotonic() >= next_report:
+                    self.logger.info(DeadlineScheduler.format_stats("Replay",
+                                                                    self.scheduler.stats()))
+                    next_report += SCHED_REPORT_S
+                self.scheduler.wait()
+        except KeyboardInterrupt:
+            print()
+        finally:
+            if self.sender.impairment:
+                self.sender.impairment.drain()
+            self.sender.close()
+
+        elapsed = time.perf_counter() - start
+        self.logger.success(f"Replay done: {tick} packets in {elapsed:.2f} s "
+                            f"({tick / elapsed if elapsed > 0 else 0:.0f} Hz), "
+                            f"sha256 {self.digest.hexdigest()[:16]}")
+        if self.sender.impairment:
+            self.logger.info(NetworkImpairment.format_stats(self.sender.impairment.stats()))
+        return tick
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Replay a controller session to the ESP32")
+    parser.add_argument("file", nargs="?", help="session file (main.py --headless --record)")
+    parser.add_argument("--synth", choices=SYNTH_KINDS, help="generate a synthetic session instead")
+    parser.add_argument("--seconds", type=float, default=30.0, help="synthetic session length")
+    parser.add_argument("--seed", type=int, default=0, help="synthetic 'noise' seed")
+    parser.add_argument("--out", help="write the synthetic session to this file and exit")
+    parser.add_argument("--speed", type=float, default=1.0, help="send rate multiplier")
+    parser.add_argument("--loop", type=int, default=1, help="passes over the session (0 = forever)")
+    parser.add_argument("--impair", metavar="SPEC",
+                        help='emulate a bad link, e.g. "loss=0.05,burst_enter=0.01,delay_ms=5,seed=2"')
+    parser.add_argument("--host", help="ESP32 address (default: settings.ESP32_HOST)")
+    parser.add_argument("--port", type=int, help="ESP32 UDP port (default: settings.ESP32_PORT)")
+    args = parser.parse_args()
+    if bool(args.file) == bool(args.synth):
+        parser.error("give a session file or --synth")
+    try:
+        impair = NetworkImpairment.parse_spec(args.impair) if args.impair else None
+    except ValueError as e:
+        parser.error(str(e))
+
+    logger = Logger(component_name="replay")
+    if args.synth:
+        records = synth_session(args.synth, args.seconds, TICK_HZ, args.seed)
+        if args.out:
+            write_session(args.out, records, TICK_HZ)
+            logger.success(f"{len(records)} records written to {args.out}")
+            return 0
+    else:
+        tick_hz, records = read_session(args.file)
+        if tick_hz != TICK_HZ:
+            logger.info(f"Session recorded at {tick_hz} Hz, replayed on a {TICK_HZ} Hz grid")
+    if not records:
+        logger.failure("Empty session")
+        return 1
+    logger.info(f"{len(records)} records, {records[-1][0] / 1e6:.1f} s, "
+                f"speed x{args.speed}, passes {args.loop or 'forever'}")
+
+    sender = UDPSender(ControllerState(), logger)
+    if args.host or args.port:
+        sender.target_address = (args.host or sender.target_address[0],
+                                 args.port or sender.target_address[1])
+    if impair is not None:
+        sender.impairment = NetworkImpairment(impair)
+    player = SessionPlayer(records, sender, logger, speed=args.speed, loops=args.loop)
+    return 0 if player.run() else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
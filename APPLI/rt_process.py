@@ -0,0 +1,212 @@
+import multiprocessing as mp
+import os
+import queue
+import signal
+import sys
+import threading
+from typing import Dict, Optional
+
+from PyQt5.QtCore import QObject, QTimer, pyqtSignal
+
+from logger import Logger
+from seqlock import SeqlockBlock
+from settings import RT_CPU, RT_PRIORITY, SCHED_SWITCH_INTERVAL_S, UI_HZ
+
+# UI snapshot published by the worker: lx, ly, rx, ry, lt, rt, UI buttons mask, dpad, connected
+UI_STATE_FMT = "<6fIi?"
+
+
+class RealtimeProcess(QObject):
+    """
+    Runs the reader + sender loop (pipeline.FusedPipeline) in its own process.
+
+    In the GUI process the loop would share the GIL with the Qt main thread,
+    the WebChannel bridge and the logger: any slow slot or log call shows up
+    as send jitter. Here the worker has its own interpreter, optionally
+    pinned to RT_CPU and scheduled SCHED_FIFO at RT_PRIORITY, and the UI only
+    observes it:
+
+    - controller snapshots (already decimated to UI_HZ by the loop) through a
+      seqlock block in shared memory: the worker never waits on the UI;
+    - logs, connection changes, telemetry, UDP status and tick stats through
+      a multiprocessing queue, low rate.
+
+    Same start/stop interface and signals as FusedPipeline, so MainWindow
+    drives either one.
+    """
+
+    state_changed = pyqtSignal(dict)       # UI state copy (lx, ly, ..., buttons, dpad, connected)
+    connection_changed = pyqtSignal(bool)
+    telemetry_received = pyqtSignal(dict)
+    udp_status_changed = pyqtSignal(str)
+    tick_stats_reported = pyqtSignal(dict)
+    log_record = pyqtSignal(str, str)      # (level, formatted message) from the worker
+
+    def __init__(self, logger: Logger, parent=None, report_s: Optional[float] = None,
+                 target: Optional[tuple] = None, priority: int = RT_PRIORITY,
+                 cpu: Optional[int] = RT_CPU, console: bool = True):
+        """
+        Args:
+            logger: UI-process logger (worker lifecycle messages)
+            parent: Qt parent
+            report_s: Tick stats period in the worker (default SCHED_REPORT_S)
+            target: (host, port) overriding settings.ESP32_HOST/ESP32_PORT
+            priority: SCHED_FIFO priority of the worker, 0 = normal scheduling
+            cpu: CPU to pin the worker to, None = no affinity
+            console: Worker also prints its log on this terminal
+        """
+        super().__init__(parent)
+        self.logger = logger
+        self._ctx = mp.get_context("spawn")    # no fork of a process running Qt threads
+        self._buf = self._ctx.RawArray("B", SeqlockBlock.size_for(UI_STATE_FMT))
+        self._block = SeqlockBlock(self._buf, UI_STATE_FMT)
+        self._options = {"report_s": report_s, "target": target,
+                         "priority": priority, "cpu": cpu, "console": console}
+        self._proc = None
+        self._stop = None
+        self._messages = None
+        self._seen_seq = 0
+        self.connected = False   # Last controller status reported by the worker
+
+        self._timer = QTimer(self)
+        self._timer.setInterval(int(1000 / UI_HZ))
+        self._timer.timeout.connect(self.poll)
+
+    def start_pipeline(self):
+        """Spawn the worker (no-op if it is running)."""
+        if self.isRunning():
+            return
+        self._stop = self._ctx.Event()
+        self._messages = self._ctx.Queue()
+        self._proc = self._ctx.Process(target=worker_main, name="vroom-rt", daemon=True,
+                                       args=(self._buf, self._stop, self._messages, self._options))
+        self._proc.start()
+        self._timer.start()
+        self.logger.info(f"Real-time sender process started (pid {self._proc.pid})")
+
+    def stop_pipeline(self):
+        """Ask the worker to stop, then reap it."""
+        if self._proc is None:
+            return
+        self._stop.set()
+        self._proc.join(3.0)
+        if self._proc.is_alive():
+            self.logger.failure("Real-time sender process did not stop, terminating it")
+            self._proc.terminate()
+            self._proc.join(1.0)
+        self.poll()
+        if self.connected:   # Killed before it could report the disconnect
+            self.connected = False
+            self.connection_changed.emit(False)
+        self._timer.stop()
+        self._proc = None
+        self.logger.info("Real-time sender process stopped")
+
+    def isRunning(self) -> bool:
+        return self._proc is not None and self._proc.is_alive()
+
+    def poll(self):
+        """UI frame: forward queued worker events, then the latest snapshot if it changed."""
+        if self._messages is not None:
+            while True:
+                try:
+                    kind, *payload = self._messages.get_nowait()
+                except (queue.Empty, OSError, EOFError):
+                    break
+                self._dispatch(kind, payload)
+
+        seq = self._block.sequence()
+        if seq == self._seen_seq:
+            return
+        snap = self._block.read()
+        if snap is None:
+            return   # Writer busy the whole time: next frame
+        self._seen_seq, (lx, ly, rx, ry, lt, rt, buttons, dpad, connected) = snap
+        self.connected = connected
+        self.state_changed.emit({"lx": lx, "ly": ly, "rx": rx, "ry": ry, "lt": lt, "rt": rt,
+                                 "buttons": buttons, "dpad": dpad, "connected": connected})
+
+    def _dispatch(self, kind: str, payload: list):
+        if kind == "log":
+            self.log_record.emit(*payload)
+        elif kind == "connected":
+            self.connected = payload[0]
+            self.connection_changed.emit(payload[0])
+        elif kind == "telemetry":
+            self.telemetry_received.emit(payload[0])
+        elif kind == "udp":
+            self.udp_status_changed.emit(payload[0])
+        elif kind == "ticks":
+            self.tick_stats_reported.emit(payload[0])
+
+
+# =============================================================================
+# Worker process
+# =============================================================================
+def _enter_realtime(priority: int, cpu: Optional[int], logger: Logger):
+    """Pin to a CPU and switch to SCHED_FIFO when asked (Linux; skipped elsewhere)."""
+    if cpu is not None:
+        if hasattr(os, "sched_setaffinity"):
+            try:
+                os.sched_setaffinity(0, {cpu})
+                logger.info(f"Real-time worker pinned to CPU {cpu}")
+            except OSError as e:
+                logger.failure(f"CPU affinity {cpu} not applied: {e}")
+        else:
+            logger.info("CPU affinity not supported on this platform")
+    if priority:
+        if hasattr(os, "SCHED_FIFO"):
+            try:
+                os.sched_setscheduler(0, os.SCHED_FIFO, os.sched_param(priority))
+                logger.success(f"Real-time worker on SCHED_FIFO priority {priority}")
+            except OSError as e:
+                # Needs CAP_SYS_NICE or an rtprio limit (/etc/security/limits.conf)
+                logger.failure(f"SCHED_FIFO {priority} refused ({e}), normal scheduling")
+        else:
+            logger.info("SCHED_FIFO not supported on this platform")
+
+
+def worker_main(state_buf, stop_event, messages, options: Dict):
+    """Process entry: fused poll + send loop, publishing to the UI process."""
+    # The parent owns shutdown (Ctrl+C reaches the whole process group)
+    signal.signal(signal.SIGINT, signal.SIG_IGN)
+    sys.setswitchinterval(SCHED_SWITCH_INTERVAL_S)
+
+    # Imported here: the UI process does not need them for the observer side
+    from controller_state import ControllerState
+    from gamepad_reader import GamepadReader
+    from pipeline import FusedPipeline
+    from udp_sender import UDPSender
+
+    logger = Logger(enable_console=options.get("console", True), component_name="rt")
+    post = messages.put    # Queue feeder thread: the loop never blocks on the UI
+    logger.logRecord.connect(lambda level, text: post(("log", level, text)))
+    _enter_realtime(options.get("priority", 0), options.get("cpu"), logger)
+
+    block = SeqlockBlock(state_buf, UI_STATE_FMT)
+    state = ControllerState()
+    state.set_logger(logger)
+    reader = GamepadReader(state, logger)
+    sender = UDPSender(state, logger)
+    if options.get("target"):
+        sender.target_address = tuple(options["target"])
+    pipeline = FusedPipeline(reader, sender, logger)
+    if options.get("report_s"):
+        pipeline.report_s = options["report_s"]
+
+    # No event loop in this process: these run inline, on the loop thread
+    pipeline.state_changed.connect(
+        lambda ui: block.write(ui["lx"], ui["ly"], ui["rx"], ui["ry"], ui["lt"], ui["rt"],
+                               ui["buttons"], ui["dpad"], ui["connected"]))
+    pipeline.connection_changed.connect(lambda c: post(("connected", c)))
+    pipeline.tick_stats_reported.connect(lambda s: post(("ticks", s)))
+    sender.telemetry_received.connect(lambda t: post(("telemetry", t)))
+    sender.connection_status_changed.connect(lambda s: post(("udp", s)))
+
+    def wait_stop():
+        stop_event.wait()
+        pipeline.running = False
+    threading.Thread(target=wait_stop, name="rt-stop", daemon=True).start()
+
+    pipeline.running = True
+    pipeline.run()   # This process's main thread is the real-time loop
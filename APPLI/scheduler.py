@@ -0,0 +1,130 @@
+import time
+from typing import Optional
+
+from settings import SCHED_SPIN_US
+
+# Lateness histogram: 10 µs buckets up to 5 ms, last bucket catches the rest
+_BUCKET_US = 10
+_BUCKETS = 500
+
+
+class DeadlineScheduler:
+    """
+    Fixed-rate loop pacing on absolute deadlines.
+
+    Deadlines are computed from the start time (start + n * period), never from
+    the end of the previous tick, so work time and sleep overshoot do not make
+    the rate drift below its target. Each wait sleeps until SCHED_SPIN_US before
+    the deadline, then spins on perf_counter() for the last stretch, because
+    time.sleep() on a stock kernel overshoots by 50-100 µs or more.
+
+    A tick whose work ran past the next deadline is an overrun; deadlines missed
+    entirely are skipped rather than replayed in a burst.
+    """
+
+    def __init__(self, rate_hz: float, spin_us: Optional[float] = None):
+        self.period = 1.0 / rate_hz
+        self.rate_hz = rate_hz
+        self._spin = (SCHED_SPIN_US if spin_us is None else spin_us) / 1e6
+        self._next = None
+        self._reset_window()
+
+    def reset(self):
+        """Restart the deadline grid from now (after a pause or an error)."""
+        self._next = time.perf_counter() + self.period
+
+    def wait(self) -> int:
+        """
+        Block until the next deadline.
+
+        Returns:
+            Number of deadlines skipped because the loop fell a full period behind
+        """
+        if self._next is None:
+            self.reset()
+        deadline = self._next
+        now = time.perf_counter()
+
+        skipped = 0
+        if now > deadline:
+            # Work overran the tick: run immediately, drop whole periods already lost
+            self._overruns += 1
+            skipped = int((now - deadline) / self.period)
+            deadline += skipped * self.period
+            self._skipped += skipped
+        else:
+            coarse = deadline - now - self._spin
+            if coarse > 0:
+                time.sleep(coarse)
+            while time.perf_counter() < deadline:
+                pass
+            now = time.perf_counter()
+
+        self._record(now - deadline)
+        self._next = deadline + self.period
+        return skipped
+
+    def _record(self, late_s: float):
+        late_us = late_s * 1e6
+        self._n += 1
+        self._sum_us += late_us
+        if late_us > self._max_us:
+            self._max_us = late_us
+        self._hist[min(int(late_us) // _BUCKET_US, _BUCKETS - 1)] += 1
+
+    def _reset_window(self):
+        self._n = 0
+        self._sum_us = 0.0
+        self._max_us = 0.0
+        self._overruns = 0
+        self._skipped = 0
+        self._hist = [0] * _BUCKETS
+        self._window_start = time.perf_counter()
+
+    def stats(self, reset: bool = True) -> dict:
+        """
+        Wake-up lateness statistics since the last reset.
+
+        Returns:
+            Dict with ticks, measured rate, mean/p99/max lateness (µs), overruns
+            and skipped deadlines
+        """
+        elapsed = time.perf_counter() - self._window_start
+        p99 = 0
+        target = self._n * 0.99
+        acc = 0
+        for i, count in enumerate(self._hist):
+            acc += count
+            if count and acc >= target:
+                p99 = (i + 1) * _BUCKET_US
+                break
+        result = {
+            "ticks": self._n,
+            "rate_hz": self._n / elapsed if elapsed > 0 else 0.0,
+            "mean_us": self._sum_us / self._n if self._n else 0.0,
+            "p99_us": p99,
+            "max_us": self._max_us,
+            "overruns": self._overruns,
+            "skipped": self._skipped,
+        }
+        if reset:
+            self._reset_window()
+        return result
+
+    @staticmethod
+    def format_stats(name: str, s: dict) -> str:
+        """One log line for a stats() result."""
+        return (f"{name} tick: {s['rate_hz']:.1f} Hz, late mean={s['mean_us']:.0f} us "
+                f"p99<={s['p99_us']} us max={s['max_us']:.0f} us, "
+                f"overruns={s['overruns']} skipped={s['skipped']}")
+
+
+if __name__ == "__main__":
+    # Standalone check: python3 scheduler.py [rate_hz] [seconds]
+    import sys
+    rate = float(sys.argv[1]) if len(sys.argv) > 1 else 1000.0
+    seconds = float(sys.argv[2]) if len(sys.argv) > 2 else 5.0
+    sched = DeadlineScheduler(rate)
+    for _ in range(int(rate * seconds)):
+        sched.wait()
+    print(DeadlineScheduler.format_stats("scheduler", sched.stats()))
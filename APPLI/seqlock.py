@@ -0,0 +1,88 @@
+import struct
+import time
+from typing import Optional, Tuple
+
+_SEQ = struct.Struct("<I")
+
+
+class SeqlockBlock:
+    """
+    Single-writer seqlock over a fixed-layout record in a shared buffer.
+
+    The buffer holds a 32-bit sequence number followed by the payload packed
+    with payload_fmt. The writer makes the sequence odd, writes the payload,
+    then makes it even again; a reader copies the payload between two reads of
+    the sequence and retries if they differ or are odd. The writer never
+    waits for readers, and readers never see a half-written record. A reader
+    that hits a write in progress yields before retrying: a writer thread of
+    the same process may have been switched out mid-record, and spinning on
+    the GIL would not let it finish.
+
+    The buffer can be a bytearray (threads) or shared memory from
+    multiprocessing (RawArray): no lock is shared across processes. Ordering
+    relies on the stores of pack_into() becoming visible in program order, as
+    on x86; this is the platform the sender runs on.
+    """
+
+    def __init__(self, buffer, payload_fmt: str, offset: int = 0):
+        self._buf = buffer
+        self._offset = offset
+        self._payload = struct.Struct(payload_fmt)
+        self._seq = _SEQ.unpack_from(buffer, offset)[0] & ~1   # writer-side copy
+        # Raw payload bytes, for readers that copy the record as is
+        self._payload_view = memoryview(buffer).cast("B")[offset + _SEQ.size:
+                                                          offset + _SEQ.size + self._payload.size]
+
+    @staticmethod
+    def size_for(payload_fmt: str) -> int:
+        """Bytes a block with this payload takes in the buffer."""
+        return _SEQ.size + struct.calcsize(payload_fmt)
+
+    def write(self, *fields):
+        """Publish a new record (single writer only)."""
+        buf, off = self._buf, self._offset
+        self._seq += 1
+        _SEQ.pack_into(buf, off, self._seq & 0xFFFFFFFF)
+        self._payload.pack_into(buf, off + _SEQ.size, *fields)
+        self._seq += 1
+        _SEQ.pack_into(buf, off, self._seq & 0xFFFFFFFF)
+
+    def sequence(self) -> int:
+        """Current sequence number (even when no write is in progress)."""
+        return _SEQ.unpack_from(self._buf, self._offset)[0]
+
+    def read_into(self, dest, max_tries: int = 1000) -> Optional[int]:
+        """
+        Copy the packed payload into dest (a writable buffer of the payload size).
+
+        Returns:
+            Sequence of the copied record, or None if no consistent copy was
+            made in max_tries attempts (dest then holds an unspecified mix)
+        """
+        buf, off, view = self._buf, self._offset, self._payload_view
+        for _ in range(max_tries):
+            s1 = _SEQ.unpack_from(buf, off)[0]
+            if not s1 & 1:
+                dest[:] = view
+                if _SEQ.unpack_from(buf, off)[0] == s1:
+                    return s1
+            time.sleep(0)
+        return None
+
+    def read(self, max_tries: int = 1000) -> Optional[Tuple[int, tuple]]:
+        """
+        Copy out a consistent record.
+
+        Returns:
+            (sequence, fields), or None if the writer kept the block busy for
+            max_tries attempts
+        """
+        buf, off = self._buf, self._offset
+        for _ in range(max_tries):
+            s1 = _SEQ.unpack_from(buf, off)[0]
+            if not s1 & 1:
+                fields = self._payload.unpack_from(buf, off + _SEQ.size)
+                if _SEQ.unpack_from(buf, off)[0] == s1:
+                    return s1, fields
+            time.sleep(0)
+        return None
@@ -0,0 +1,161 @@
+import random
+import struct
+import time
+from typing import BinaryIO, List, Optional, Tuple
+
+from controller_state import ControllerState, UDP_BUTTON_MASKS
+
+# File: header, then one record per state change
+#   header  <4sHHQ : magic, version, tick rate (Hz) at recording, start (unix µs)
+#   record  <II6f  : µs since the previous record, buttons, lx, ly, rx, ry, lt, rt
+SESSION_MAGIC = b"VVRS"
+SESSION_VERSION = 1
+_HEADER = struct.Struct("<4sHHQ")
+_RECORD = struct.Struct("<II6f")
+
+# (time since session start in µs, buttons, lx, ly, rx, ry, lt, rt)
+Record = Tuple[int, int, float, float, float, float, float, float]
+
+SYNTH_KINDS = ("sweep", "step", "noise")
+
+
+class SessionRecorder:
+    """
+    Appends ControllerState samples to a session file.
+
+    Only samples where ControllerState.revision moved are written (the
+    conditioned inputs of an idle pad do not), 32 bytes each, through a
+    buffered file: sample() is cheap enough to sit in the send loop.
+    """
+
+    def __init__(self, path: str, tick_hz: int):
+        self.path = path
+        self.count = 0
+        self._file: BinaryIO = open(path, "wb")
+        self._file.write(_HEADER.pack(SESSION_MAGIC, SESSION_VERSION, tick_hz,
+                                      int(time.time() * 1e6)))
+        self._revision = None
+        self._last_us = None
+        self._last_fields = None
+
+    def sample(self, state: ControllerState, now: Optional[float] = None):
+        """Write the state if it changed since the last sample (now: perf_counter())."""
+        if state.revision == self._revision:
+            return
+        self._revision = state.revision
+        us = int((time.perf_counter() if now is None else now) * 1e6)
+        self._last_fields = (state.udp_buttons, state.left_stick_x, state.left_stick_y,
+                             state.right_stick_x, state.right_stick_y,
+                             state.left_trigger, state.right_trigger)
+        self._write(us)
+
+    def _write(self, us: int):
+        dt = 0 if self._last_us is None else min(us - self._last_us, 0xFFFFFFFF)
+        self._last_us = us
+        self._file.write(_RECORD.pack(dt, *self._last_fields))
+        self.count += 1
+
+    def close(self):
+        """Repeat the last state at the current time (keeps the session length), then close."""
+        if self._file:
+            if self._last_fields is not None:
+                self._write(int(time.perf_counter() * 1e6))
+            self._file.close()
+            self._file = None
+
+
+def write_session(path: str, records: List[Record], tick_hz: int):
+    """Write records (e.g. a synthetic session) to a session file."""
+    with open(path, "wb") as f:
+        f.write(_HEADER.pack(SESSION_MAGIC, SESSION_VERSION, tick_hz, int(time.time() * 1e6)))
+        prev = 0
+        for t, *fields in records:
+            f.write(_RECORD.pack(t - prev, *fields))
+            prev = t
+
+
+def read_session(path: str) -> Tuple[int, List[Record]]:
+    """
+    Load a session file.
+
+    Returns:
+        (tick rate at recording, records with absolute times from the first one)
+
+    Raises:
+        ValueError: not a session file, or an unknown version
+    """
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < _HEADER.size:
+        raise ValueError(f"{path}: too short for a session file")
+    magic, version, tick_hz, _start = _HEADER.unpack_from(data)
+    if magic != SESSION_MAGIC or version != SESSION_VERSION:
+        raise ValueError(f"{path}: not a v{SESSION_VERSION} session file")
+
+    records = []
+    t = 0
+    body = memoryview(data)[_HEADER.size:]
+    usable = len(body) - len(body) % _RECORD.size   # a truncated last record is dropped
+    for dt, *fields in _RECORD.iter_unpack(body[:usable]):
+        t += dt
+        records.append((t, *fields))
+    return tick_hz, records
+
+
+def _triangle(t: float, period: float) -> float:
+    """Triangle wave, -1 at t = 0, 1 at half period."""
+    return 1.0 - 4.0 * abs((t / period) % 1.0 - 0.5)
+
+
+def synth_session(kind: str, seconds: float, tick_hz: int, seed: int = 0) -> List[Record]:
+    """
+    Generate a synthetic session on the tick grid.
+
+    Args:
+        kind: "sweep" (triangle steering, throttle ramps), "step" (steering
+            and throttle steps every second, A toggled), "noise" (seeded
+            random walk on every axis, random buttons)
+        seconds: Session length
+        tick_hz: Grid rate, one candidate sample per tick
+        seed: Random seed ("noise"): same seed, same session
+
+    Returns:
+        Records, one per tick where the state changes
+    """
+    if kind not in SYNTH_KINDS:
+        raise ValueError(f"unknown synthetic session '{kind}' (expected one of {SYNTH_KINDS})")
+    rng = random.Random(seed)
+    walk = [0.0, 0.0, 0.0, 0.0, -1.0, -1.0]
+    steer_steps = (0.0, 0.5, 1.0, 0.5, 0.0, -0.5, -1.0, -0.5)
+    throttle_steps = (-1.0, 0.0, 1.0, 0.0)
+    records: List[Record] = []
+    last = None
+
+    for n in range(int(seconds * tick_hz)):
+        t = n / tick_hz
+        if kind == "sweep":
+            fields = (0, _triangle(t, 4.0), 0.0, 0.0, 0.0, -1.0, _triangle(t, 6.0))
+        elif kind == "step":
+            s = int(t)
+            fields = (UDP_BUTTON_MASKS["A"] if s % 2 else 0,
+                      steer_steps[s % len(steer_steps)], 0.0, 0.0, 0.0,
+                      -1.0, throttle_steps[s % len(throttle_steps)])
+        else:
+            for i in range(6):
+                walk[i] = max(-1.0, min(1.0, walk[i] + rng.gauss(0.0, 0.05)))
+            buttons = 0
+            for mask in UDP_BUTTON_MASKS.values():
+                if rng.random() < 0.02:
+                    buttons |= mask
+            fields = (buttons, *walk)
+
+        # Float32 on the wire: store what will be sent
+        fields = (fields[0], *struct.unpack("<6f", struct.pack("<6f", *fields[1:])))
+        if fields != last:
+            records.append((round(t * 1e6), *fields))
+            last = fields
+    # Hold the last state to the end, so the session lasts the requested time
+    end_us = round((int(seconds * tick_hz) - 1) / tick_hz * 1e6)
+    if records and records[-1][0] != end_us:
+        records.append((end_us, *last))
+    return records
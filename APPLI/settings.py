@@ -3,10 +3,22 @@
 # Network settings
 ESP32_HOST = "192.168.4.1"
 ESP32_PORT = 5500
+UDP_TOS = 0xB8       # DSCP EF (46) -> WMM voice access category (None = OS default)
+UDP_CONNECT = False  # connect() the sender socket (no per-send address). Off: the ESP32 sends
+                     # telemetry from another port, which a connected socket would filter out
 
 # Performance settings
 TICK_HZ = 100        # UI update rate (10ms)
 POLL_HZ = 180        # Gamepad polling rate
+PIPELINE_MODE = "fused"  # "fused": one loop polls and sends at TICK_HZ; "split": reader + sender threads;
+                         # "process": the fused loop in its own process (rt_process.py), off the UI's GIL
+RT_PRIORITY = 0      # "process" mode: SCHED_FIFO priority of the worker (1-99, needs CAP_SYS_NICE); 0 = normal
+RT_CPU = None        # "process" mode: pin the worker to this CPU (None = no affinity)
+UI_HZ = 60           # UI frame rate: fused-mode decimation and WebChannel state coalescing
+SCHED_SPIN_US = 500  # Loops busy-wait the last 500 µs before each deadline (sleep overshoot)
+SCHED_REPORT_S = 10  # Tick jitter / overrun stats logged every 10 s
+SCHED_SWITCH_INTERVAL_S = 0.0005  # GIL hand-off: a waking loop is not held 5 ms by another thread
+HEADLESS_STATS_S = 1.0  # Headless mode (main.py --headless): stats line period
 
 # === Controller Mapping ===
 
@@ -111,7 +123,11 @@ UI_BUTTON_MAPPING = {
 # Input normalization ranges
 AXIS_RANGE = (-1.0, 1.0)       # Stick axes normalized range
 TRIGGER_RANGE = (-1.0, 1.0)    # Trigger normalized range (-1=released, 1=pressed)
-DEADZONE = 0.06                 # Deadzone for stick drift
+DEADZONE = 0.06                 # Radial deadzone for stick drift (vector length)
+TRIGGER_DEADZONE = 0.04         # Trigger deadzone, fraction of travel from released
+STICK_STEP = 1 / 200            # Stick quantization: 1 steering CCR count on the car (1400 - 200*lx)
+TRIGGER_STEP = 1 / 100          # Trigger quantization: half a speed CCR count (1400 + 50*(rt - lt))
+INPUT_HYSTERESIS = 0.01         # Held level moves once the input is 0.01 past the rounding edge (noise band)
 
 # UDP packet format (28 bytes total)
 UDP_PACKET_FORMAT = {
@@ -128,10 +144,39 @@ UDP_PACKET_FORMAT = {
     ]
 }
 
+# Telemetry sent back by the ESP32 to the sender socket (56 bytes, gp_telemetry_t)
+TELEMETRY_FORMAT = {
+    "struct": "<IBBbBIIIIIIHH",   # magic, version, flags, rssi, sta_count, uptime_ms, seq,
+                                  # rx_frames, drops, coalesced, spi_errors, queue_depth, reserved
+    "car_struct": "<IHHHBBIHH",   # STM32 status block (gp_car_status_t), read over MISO
+    "size": 56,
+    "magic": 0x4C455447,          # 'GTEL'
+}
+# Network impairment emulator between the formatter and the socket (impairment.py),
+# for desk tests of the ESP32/STM32 under bad Wi-Fi. Also: --impair "loss=0.05,delay_ms=5"
+NET_IMPAIRMENT = {
+    "enabled": False,
+    "seed": 1,            # Same seed, same losses/duplicates/reorders for the same packets
+    "loss": 0.0,          # Random loss probability
+    "burst_enter": 0.0,   # Bursty loss (Gilbert-Elliott): P(good -> bad) per packet
+    "burst_exit": 0.3,    # P(bad -> good) per packet (mean burst 1/0.3 packets)
+    "burst_loss": 1.0,    # Loss probability in the bad state
+    "delay_ms": 0.0,      # One-way delay
+    "jitter_ms": 0.0,     # Uniform +/- around delay_ms (order kept)
+    "duplicate": 0.0,     # Duplication probability
+    "reorder": 0.0,       # Probability a packet is held back and overtaken
+    "reorder_ms": 20.0,   # Extra delay of a reordered packet
+}
+
+TELEMETRY_STALE_MS = 2000         # UI marks the link stale without telemetry for this long
+LOG_UI_CAPACITY = 2000            # Log panel ring buffer (oldest lines dropped beyond this)
+
 # UI configuration for injection into HTML
 UI_CONFIG = {
     "buttonMapping": UI_BUTTON_MAPPING,
     "triggerRange": TRIGGER_RANGE,
     "axisRange": AXIS_RANGE,
+    "telemetryStaleMs": TELEMETRY_STALE_MS,
+    "logCapacity": LOG_UI_CAPACITY,
     "version": "2.0"
 }
\ No newline at end of file
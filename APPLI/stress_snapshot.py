@@ -0,0 +1,95 @@
+"""
+Torn-snapshot stress test for the reader -> sender handoff of ControllerState.
+
+    python3 stress_snapshot.py [seconds]
+
+A writer thread drives one ControllerState as fast as it can, the way the
+reader thread does (apply_udp_state(): fields set one at a time, then
+publish()), while a second thread packs packets from it. Every record k the
+writer sets is self-checking: buttons = k, lx = k / 2^20, ly = -lx,
+rx = lx / 2, ry = -rx, lt = lx, rt = -lx (all exact in float32), so a packet
+whose fields do not all follow from its buttons mixes two writes.
+
+Two consumers run for the given time each (default 3 s):
+  "fields"    packs the attributes directly, as the formatter did before
+              publish(): tears are expected, it shows the check catches them
+  "published" UDPFormatter.pack_state(), the seqlock copy: must stay at 0
+
+The thread switch interval is lowered to force interleavings. Exit status
+is 1 if a published packet was torn.
+"""
+import struct
+import sys
+import threading
+import time
+
+from controller_state import ControllerState
+from formatter import UDPFormatter
+from logger import Logger
+from settings import UDP_PACKET_FORMAT
+
+_WRAP = 1 << 20
+
+
+def record(k: int) -> tuple:
+    """Self-checking wire record for write number k."""
+    k %= _WRAP
+    v = k / _WRAP
+    return (k, v, -v, v / 2, -v / 2, v, -v)
+
+
+def writer(state: ControllerState, stop: threading.Event, count: list):
+    k = 0
+    while not stop.is_set():
+        k += 1
+        state.apply_udp_state(*record(k))
+    count.append(k)
+
+
+def run(seconds: float, consumer) -> tuple:
+    """Returns (writes, packets checked, torn packets) for one consumer."""
+    state = ControllerState()
+    state.apply_udp_state(*record(0))   # checkable from the first packet on
+    packer = struct.Struct(UDP_PACKET_FORMAT["struct"])
+    stop = threading.Event()
+    writes = []
+    t = threading.Thread(target=writer, args=(state, stop, writes), daemon=True)
+    t.start()
+
+    checked = torn = 0
+    end = time.perf_counter() + seconds
+    while time.perf_counter() < end:
+        fields = packer.unpack(consumer(state))
+        checked += 1
+        if fields != record(fields[0]):
+            torn += 1
+    stop.set()
+    t.join()
+    return writes[0], checked, torn
+
+
+def main():
+    seconds = float(sys.argv[1]) if len(sys.argv) > 1 else 3.0
+    sys.setswitchinterval(1e-6)
+
+    packer = struct.Struct(UDP_PACKET_FORMAT["struct"])
+    formatter = UDPFormatter(Logger(enable_console=False))
+    fields_buf = bytearray(packer.size)
+
+    def pack_fields(s: ControllerState):
+        packer.pack_into(fields_buf, 0, s.udp_buttons,
+                         s.left_stick_x, s.left_stick_y,
+                         s.right_stick_x, s.right_stick_y,
+                         s.left_trigger, s.right_trigger)
+        return fields_buf
+
+    failed = False
+    for name, consumer in (("fields", pack_fields), ("published", formatter.pack_state)):
+        writes, checked, torn = run(seconds, consumer)
+        print(f"  {name:<10} {writes:>9} writes  {checked:>9} packets  {torn:>7} torn")
+        failed |= name == "published" and torn > 0
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
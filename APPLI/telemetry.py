@@ -0,0 +1,66 @@
+import struct
+from typing import Optional
+
+from settings import TELEMETRY_FORMAT
+
+# Flags carried in the telemetry datagram (gp_proto.h, GP_TELEM_*)
+FLAG_RSSI_VALID = 1 << 0
+FLAG_STM32_VALID = 1 << 1
+
+
+class TelemetryDecoder:
+    """Decodes the gp_telemetry_t datagrams the ESP32 sends back to the sender socket."""
+
+    def __init__(self):
+        self._struct = struct.Struct(TELEMETRY_FORMAT["struct"])
+        self._car_struct = struct.Struct(TELEMETRY_FORMAT["car_struct"])
+        self._magic = TELEMETRY_FORMAT["magic"]
+
+    @property
+    def size(self) -> int:
+        return self._struct.size + self._car_struct.size
+
+    def decode(self, data: bytes) -> Optional[dict]:
+        """
+        Decode one telemetry datagram.
+
+        Args:
+            data: Raw UDP payload
+
+        Returns:
+            Telemetry dict for the UI, or None if the payload is not telemetry
+        """
+        if len(data) != self.size:
+            return None
+        (magic, version, flags, rssi, sta_count, uptime_ms, seq, rx_frames,
+         drops, coalesced, spi_errors, queue_depth, _reserved) = self._struct.unpack_from(data)
+        if magic != self._magic:
+            return None
+        return {
+            "version": version,
+            "seq": seq,
+            "uptime_s": uptime_ms / 1000.0,
+            "rssi": rssi if flags & FLAG_RSSI_VALID else None,
+            "sta_count": sta_count,
+            "rx_frames": rx_frames,
+            "drops": drops,
+            "coalesced": coalesced,
+            "spi_errors": spi_errors,
+            "queue_depth": queue_depth,
+            "car": self._decode_car(data) if flags & FLAG_STM32_VALID else None,
+        }
+
+    def _decode_car(self, data: bytes) -> dict:
+        """STM32 status block (duties it applied, its own counters, CPU load)."""
+        (_magic, seq, dir_duty, spd_duty, lights, cpu_load,
+         rx_frames, rx_overruns, spi_errors) = self._car_struct.unpack_from(data, self._struct.size)
+        return {
+            "seq": seq,
+            "dir_duty": dir_duty,
+            "spd_duty": spd_duty,
+            "lights": lights,
+            "cpu_load": cpu_load,
+            "rx_frames": rx_frames,
+            "rx_overruns": rx_overruns,
+            "spi_errors": spi_errors,
+        }
@@ -1,10 +1,15 @@
+import select
 import socket
 import time
 from PyQt5.QtCore import QThread, pyqtSignal
 from controller_state import ControllerState
 from formatter import UDPFormatter
+from impairment import NetworkImpairment
 from logger import Logger
-from settings import ESP32_HOST, ESP32_PORT, TICK_HZ
+from scheduler import DeadlineScheduler
+from settings import (ESP32_HOST, ESP32_PORT, NET_IMPAIRMENT, SCHED_REPORT_S, TICK_HZ,
+                      UDP_CONNECT, UDP_TOS)
+from telemetry import TelemetryDecoder
 
 
 class UDPSender(QThread):
@@ -12,17 +17,26 @@ class UDPSender(QThread):
     
     # Signals
     connection_status_changed = pyqtSignal(str)  # Emits "connected" or "disconnected"
+    telemetry_received = pyqtSignal(dict)        # Latest telemetry sent back by the ESP32
     
     def __init__(self, controller_state: ControllerState, logger: Logger):
         super().__init__()
         self.controller_state = controller_state
         self.logger = logger
         self.formatter = UDPFormatter(logger)
+        self.telemetry = TelemetryDecoder()
         
         self.running = False
         self.socket = None
         self.target_address = (ESP32_HOST, ESP32_PORT)
-        self.send_interval = 1.0 / TICK_HZ  # Send rate based on TICK_HZ
+        self._target = None       # target_address resolved once per socket (numeric)
+        self._connected = False   # socket connect()ed: send() without an address
+        # Emulated bad link between formatter and socket (None: packets go straight out)
+        self.impairment = NetworkImpairment() if NET_IMPAIRMENT["enabled"] else None
+        self.scheduler = DeadlineScheduler(TICK_HZ)  # Send rate based on TICK_HZ
+        self.tick_stats = {}                         # Last scheduler stats window
+        self.sent_count = 0                          # Datagrams handed to the socket
+        self.first_send_at = None                    # perf_counter() of the first one
         self._err_log_interval = 1.0 # Prevent flooding log error
         self._next_err_log = 0.0
         
@@ -48,25 +62,54 @@ class UDPSender(QThread):
         if not self._create_socket():
             return
         packet_count = 0
+        self.scheduler.reset()
+        self.scheduler.stats()
+        next_report = time.monotonic() + SCHED_REPORT_S
         while self.running:
             try:
-                packet = self.formatter.format_packet(self.controller_state)
-                if len(packet) != 28:
-                    self.logger.failure(f"UDP packet size unexpected: {len(packet)} bytes (expected 28)")
-                self._send_packet(packet, packet_count)
+                self.send_state(packet_count)
                 packet_count += 1
-                time.sleep(self.send_interval)
+                if time.monotonic() >= next_report:
+                    self._report_ticks()
+                    next_report += SCHED_REPORT_S
+                self.scheduler.wait()
             except Exception as e:
                 self.logger.failure(f"Error in UDP sender: {e}")
                 time.sleep(0.1)
+                self.scheduler.reset()
         self._close_socket()
         self.logger.info("UDP sender thread finished")
     
+    def send_state(self, packet_count: int):
+        """Format the current controller state, send it, then drain telemetry."""
+        packet = self.formatter.pack_state(self.controller_state)
+        self._send_packet(packet, packet_count)
+        self._poll_telemetry()
+
+    def open(self) -> bool:
+        """Create the socket for a loop that drives send_state() itself."""
+        return self._create_socket()
+
+    def close(self):
+        """Close the socket opened by open()."""
+        self._close_socket()
+
     def _create_socket(self) -> bool:
         """Create UDP socket."""
         try:
             self.socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
             self.socket.settimeout(1.0)  # 1 second timeout
+            self._set_tos()
+            # Resolve once here rather than on every sendto()
+            self._target = socket.getaddrinfo(*self.target_address, socket.AF_INET,
+                                              socket.SOCK_DGRAM)[0][4]
+            self._connected = False
+            if UDP_CONNECT:
+                self.socket.connect(self._target)
+                self._connected = True
+            if self.impairment:
+                self.impairment.start(self._raw_send)
+                self.logger.info(f"Network impairment on: {self.impairment.describe()}")
             self.logger.success(f"UDP socket created for {self.target_address}")
             self.connection_status_changed.emit("connected")
             return True
@@ -75,13 +118,31 @@ class UDPSender(QThread):
             self.connection_status_changed.emit("disconnected")
             return False
     
-    def _send_packet(self, packet: bytes, packet_count: int):
+    def _set_tos(self):
+        """Mark control packets EF so the Wi-Fi driver queues them in the voice AC."""
+        if UDP_TOS is None or not hasattr(socket, "IP_TOS"):
+            return
+        try:
+            self.socket.setsockopt(socket.IPPROTO_IP, socket.IP_TOS, UDP_TOS)
+        except OSError as e:
+            # Windows ignores or rejects IP_TOS without a QoS policy: keep best effort
+            self.logger.info(f"IP_TOS not applied ({e}), using best-effort priority")
+
+    def _send_packet(self, packet: bytearray, packet_count: int):
         """Send UDP packets and logs (first 5 packets then 1 every second)"""
         try:
-            if packet_count % 60 == 0 or packet_count < 5:
+            if packet_count % TICK_HZ == 0 or packet_count < 5:
                 self._log_packet_details(packet, packet_count + 1)
 
-            self.socket.sendto(packet, self.target_address)
+            if self.impairment:
+                self.impairment.submit(bytes(packet))  # Held past this tick: copy the buffer
+            elif self._connected:
+                self.socket.send(packet)
+            else:
+                self.socket.sendto(packet, self._target)
+            if self.first_send_at is None:
+                self.first_send_at = time.perf_counter()
+            self.sent_count += 1
 
             if packet_count % 300 == 0:
                 self.connection_status_changed.emit("connected")
@@ -95,14 +156,47 @@ class UDPSender(QThread):
                     self.logger.failure(f"UDP send error: {e}")
                 except Exception:
                     pass  # prevents crash when logger destroyed
-                self._next_err_log = now + self.err_log_interval
+                self._next_err_log = now + self._err_log_interval
             self.connection_status_changed.emit("disconnected")
         except Exception as e:
             self.logger.failure(f"Unexpected error sending UDP: {e}")
     
+    def _raw_send(self, packet: bytes):
+        """Socket send used by the impairment layer (its delivery thread)."""
+        if self._connected:
+            self.socket.send(packet)
+        else:
+            self.socket.sendto(packet, self._target)
+
+    def _report_ticks(self):
+        """Log send-loop jitter and overruns for the last window."""
+        self.tick_stats = self.scheduler.stats()
+        self.logger.info(DeadlineScheduler.format_stats("UDP sender", self.tick_stats))
+        if self.impairment:
+            self.logger.info(NetworkImpairment.format_stats(self.impairment.stats()))
+
+    def _poll_telemetry(self):
+        """Drain telemetry the ESP32 sent back to this socket, without blocking the send loop."""
+        latest = None
+        try:
+            while select.select([self.socket], [], [], 0)[0]:
+                data, _addr = self.socket.recvfrom(256)
+                telemetry = self.telemetry.decode(data)
+                if telemetry is not None:
+                    latest = telemetry
+        except OSError as e:
+            # Windows reports ICMP port unreachable on the next recv (ESP32 not up yet)
+            now = time.monotonic()
+            if now >= self._next_err_log:
+                self.logger.failure(f"Telemetry receive error: {e}")
+                self._next_err_log = now + self._err_log_interval
+        if latest is not None:
+            self.telemetry_received.emit(latest)
+
     def _log_packet_details(self, packet: bytes, packet_count: int):
         """Log detailed packet information."""
         # Convert bytes to hex string
+        packet = bytes(packet)  # Snapshot: the send buffer is reused next tick
         hex_bytes = ' '.join(f'{b:02x}' for b in packet)
         
         # Log the raw bytes
@@ -114,6 +208,8 @@ class UDPSender(QThread):
     
     def _close_socket(self):
         """Close UDP socket."""
+        if self.impairment:
+            self.impairment.stop()
         if self.socket:
             try:
                 self.socket.close()
@@ -126,8 +222,11 @@ class UDPSender(QThread):
     def get_connection_info(self) -> dict:
         """Get UDP connection information."""
         return {
-            "target_host": ESP32_HOST,
-            "target_port": ESP32_PORT,
+            "target_host": self.target_address[0],
+            "target_port": self.target_address[1],
             "socket_active": self.socket is not None,
-            "send_rate_hz": TICK_HZ
+            "send_rate_hz": TICK_HZ,
+            "sent_count": self.sent_count,
+            "tick_stats": self.tick_stats,
+            "impairment": self.impairment.stats() if self.impairment else None
         }
\ No newline at end of file
@@ -1,7 +1,8 @@
-from PyQt5.QtCore import QThread, pyqtSignal, QTimer
+from collections import deque
+from PyQt5.QtCore import QObject, QThread, pyqtSignal, pyqtSlot, QTimer
 from controller_state import ControllerState
 from logger import Logger
-from settings import TICK_HZ
+from settings import LOG_UI_CAPACITY, TICK_HZ, UI_HZ
 
 
 class UIBridge(QThread):
@@ -61,4 +62,107 @@ class UIBridge(QThread):
     
     def force_ui_update(self):
         """Force an immediate UI update."""
-        self._update_ui()
\ No newline at end of file
+        self._update_ui()
+
+
+class UIStateCoalescer(QObject):
+    """
+    Forwards controller snapshots to the page at most once per UI frame.
+
+    Producers call offer() as often as they like (it only keeps the latest
+    snapshot). A UI_HZ timer in the GUI thread compares that snapshot with what
+    the page already has and emits only the changed fields through
+    Bridge.stateChanged, instead of evaluating JS source with runJavaScript.
+    Floats are rounded to the display resolution so sensor noise below it
+    does not count as a change.
+    """
+
+    def __init__(self, logger: Logger, parent=None):
+        super().__init__(parent)
+        self.logger = logger
+        self._bridge = None
+        self._latest = None      # Newest snapshot not yet compared
+        self._last = None        # Newest snapshot seen (replayed on resync)
+        self._sent = {}          # Field values the page currently shows
+
+        self._timer = QTimer(self)
+        self._timer.setInterval(int(1000 / UI_HZ))
+        self._timer.timeout.connect(self.flush)
+
+    def attach(self, bridge):
+        """Start forwarding through the WebChannel bridge."""
+        if self._bridge is bridge:
+            return
+        self._bridge = bridge
+        bridge.resyncRequested.connect(self.resync)
+        self._timer.start()
+        self.logger.info(f"UI state coalescer attached ({UI_HZ}Hz, changed fields only)")
+
+    def offer(self, state: dict):
+        """Keep the latest snapshot; older unsent ones are simply replaced."""
+        self._latest = state
+
+    def resync(self):
+        """Page (re)subscribed: send every field on the next frame."""
+        self._sent = {}
+        if self._latest is None:
+            self._latest = self._last
+
+    def flush(self):
+        """Emit the fields that changed since the last frame, if any."""
+        state, self._latest = self._latest, None
+        if state is None or self._bridge is None:
+            return
+        self._last = state
+
+        delta = {}
+        for key, value in state.items():
+            if isinstance(value, float):
+                value = round(value, 3)
+            if key not in self._sent or self._sent[key] != value:
+                delta[key] = value
+                self._sent[key] = value
+        if delta:
+            self._bridge.stateChanged.emit(delta)
+
+
+class UILogSink(QObject):
+    """
+    Batches log records for the page log panel, once per UI frame.
+
+    Records are queued in a deque bounded to LOG_UI_CAPACITY (the size of the
+    page ring buffer, so older ones would be evicted there anyway) and sent as
+    one Bridge.logBatch per frame instead of one runJavaScript per message.
+    Nothing is sent until the page has subscribed (Bridge.request_state), so
+    the startup backlog is not lost.
+    """
+
+    def __init__(self, parent=None):
+        super().__init__(parent)
+        self._bridge = None
+        self._pending = deque(maxlen=LOG_UI_CAPACITY)
+
+        self._timer = QTimer(self)
+        self._timer.setInterval(int(1000 / UI_HZ))
+        self._timer.timeout.connect(self.flush)
+
+    def attach(self, bridge):
+        """Send through the WebChannel bridge once the page is listening."""
+        if self._bridge is bridge:
+            return
+        self._bridge = bridge
+        bridge.resyncRequested.connect(self._timer.start)
+
+    @pyqtSlot(str, str)
+    def append(self, level: str, message: str):
+        """Queue one record (GUI thread, queued from any logging thread)."""
+        self._pending.append([level, message])
+
+    def flush(self):
+        """Send the records queued since the last frame."""
+        if not self._pending or self._bridge is None:
+            return
+        batch = list(self._pending)
+        self._pending.clear()
+        self._bridge.logBatch.emit(batch)
+
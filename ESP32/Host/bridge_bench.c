@@ -0,0 +1,259 @@
+/**
+ * @file    bridge_bench.c
+ * @brief   Banc PC du pont UDP→SPI : débit soutenable, latence et pertes
+ *          selon la longueur de la file (APP_QUEUE_LEN).
+ *
+ * @project Projet immersif – ESP32
+ * @author  Hrithik SHEIKH
+ * @date    2025-09-15
+ *
+ * @details udp_server.c et spi_link.c d’origine tournent sur la couche
+ *          mock (pthreads, sockets de l’hôte, SPI simulé à 1 MHz). Un
+ *          générateur envoie des gp_packet_t à cadence fixe sur 127.0.0.1 ;
+ *          chaque trame porte son numéro (buttons) et son instant d’envoi
+ *          (rx/ry), relus par le hook SPI à la fin de la transaction.
+ *
+ *          Chaque cas (file, cadence) tourne dans un processus fils : les
+ *          tâches du pont ne s’arrêtent jamais et le port reste lié.
+ *
+ *            bridge_bench                   matrice files x cadences
+ *            bridge_bench --queue 8         une seule longueur de file
+ *            bridge_bench --rate 2000       une seule cadence
+ *            bridge_bench --seconds 5       durée par cas (2 s par défaut)
+ *            bridge_bench --smoke           test court (ctest)
+ *
+ *          Soutenable : >= 99 % des trames envoyées sur le bus et p99 sous
+ *          la période nominale (CONFIG_GP_UDP_NOMINAL_PERIOD_MS).
+ */
+#include "sdkconfig.h"
+#include "main.h"
+#include "gp_proto.h"
+#include "udp_server.h"
+#include "spi_link.h"
+#include "driver/spi_master.h"
+#include "esp_log.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#define BENCH_SECONDS     2.0
+#define BENCH_SETTLE_MS   200          // vidage du pont après le dernier envoi
+#define BENCH_MIN_RATIO   0.99
+#define BENCH_P99_MAX_US  (CONFIG_GP_UDP_NOMINAL_PERIOD_MS * 1000u)
+
+static const unsigned s_queues[] = { 1, 4, 16, APP_QUEUE_LEN };
+static const unsigned s_rates[]  = { 100, 250, 500, 1000, 1500, 2000, 4000, 8000 };
+#define COUNT(a)  (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+    unsigned queue_len, rate_hz;
+    uint32_t sent;          // datagrammes émis par le générateur
+    uint32_t rx;            // udp_rx_count()
+    uint32_t spi;           // trames du générateur vues sur le bus
+    uint32_t drops;         // udp_drop_count()
+    uint32_t coalesced;     // udp_coalesced_count()
+    uint32_t p50_us, p99_us, max_us;
+} bench_result_t;
+
+/* ============================ état du fils =============================== */
+static pthread_mutex_t s_mx = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t *s_lat_us;
+static uint32_t  s_lat_cap, s_lat_n;
+static uint16_t  s_car_seq;
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Fin de transaction : latence envoi UDP → fin SPI, et statut STM32 sur MISO */
+static void spi_hook(const uint8_t *tx, uint8_t *rx, size_t len, int64_t start_ns, int64_t end_ns)
+{
+    (void)start_ns;
+    gp_packet_t p;
+    int64_t sent_ns;
+    memcpy(&p, tx, sizeof(p));
+    memcpy(&sent_ns, &p.rx, sizeof(sent_ns));
+
+    pthread_mutex_lock(&s_mx);
+    if (sent_ns > 0 && s_lat_n < s_lat_cap) s_lat_us[s_lat_n++] = (uint32_t)((end_ns - sent_ns) / 1000);
+
+    /* Décalé de 3 octets comme un esclave armé sur NSS */
+    gp_car_status_t st = { .magic = GP_CAR_STATUS_MAGIC, .seq = ++s_car_seq };
+    if (len >= 3 + sizeof(st)) memcpy(rx + 3, &st, sizeof(st));
+    pthread_mutex_unlock(&s_mx);
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static bench_result_t run_case(unsigned queue_len, unsigned rate_hz, double seconds)
+{
+    bench_result_t r = { .queue_len = queue_len, .rate_hz = rate_hz };
+    uint32_t n = (uint32_t)(rate_hz * seconds);
+
+    s_lat_cap = n;
+    s_lat_us  = calloc(n ? n : 1, sizeof(*s_lat_us));
+    if (!s_lat_us) exit(2);
+
+    esp_log_level_set("*", ESP_LOG_WARN);
+    mock_spi_set_hook(spi_hook);
+    ESP_ERROR_CHECK(spi_link_init(APP_SPI_FRAME_SIZE, PIN_MOSI, PIN_MISO, PIN_SCLK, PIN_CS));
+    QueueHandle_t q = xQueueCreate(queue_len, sizeof(udp_rx_item_t));
+    ESP_ERROR_CHECK(udp_server_start(q));
+    vTaskDelay(pdMS_TO_TICKS(100));       // bind() de udp_task
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in dst = {
+        .sin_family = AF_INET,
+        .sin_port   = htons(GP_UDP_PORT),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    if (sock < 0 || connect(sock, (struct sockaddr *)&dst, sizeof(dst)) < 0) exit(2);
+
+    /* Cadence fixe sur échéances absolues : pas de dérive si un envoi traîne */
+    int64_t period = 1000000000 / rate_hz;
+    int64_t next = now_ns();
+    for (uint32_t i = 0; i < n; ++i) {
+        gp_packet_t p = { .buttons = i, .lx = 0.25f, .ly = -0.25f, .lt = 0.f, .rt = 0.5f };
+        int64_t t = now_ns();
+        memcpy(&p.rx, &t, sizeof(t));     // rx/ry : horodatage d’envoi
+        if (send(sock, &p, sizeof(p), 0) == (ssize_t)sizeof(p)) r.sent++;
+
+        next += period;
+        struct timespec until = { .tv_sec = next / 1000000000, .tv_nsec = next % 1000000000 };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) == EINTR) { }
+    }
+    close(sock);
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SETTLE_MS));
+
+    pthread_mutex_lock(&s_mx);
+    r.spi       = s_lat_n;
+    r.rx        = udp_rx_count();
+    r.drops     = udp_drop_count();
+    r.coalesced = udp_coalesced_count();
+    if (s_lat_n) {
+        qsort(s_lat_us, s_lat_n, sizeof(*s_lat_us), cmp_u32);
+        r.p50_us = s_lat_us[s_lat_n / 2];
+        r.p99_us = s_lat_us[(uint32_t)((s_lat_n - 1) * 0.99)];
+        r.max_us = s_lat_us[s_lat_n - 1];
+    }
+    pthread_mutex_unlock(&s_mx);
+    return r;
+}
+
+/* Un cas par processus fils, résultat renvoyé par un pipe */
+static int run_forked(unsigned queue_len, unsigned rate_hz, double seconds, bench_result_t *out)
+{
+    int fd[2];
+    if (pipe(fd) < 0) return -1;
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        close(fd[0]);
+        bench_result_t r = run_case(queue_len, rate_hz, seconds);
+        _exit(write(fd[1], &r, sizeof(r)) == (ssize_t)sizeof(r) ? 0 : 1);
+    }
+
+    close(fd[1]);
+    ssize_t got;
+    do { got = read(fd[0], out, sizeof(*out)); } while (got < 0 && errno == EINTR);
+    close(fd[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+    return (got == (ssize_t)sizeof(*out) && WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : -1;
+}
+
+static bool sustainable(const bench_result_t *r)
+{
+    return r->sent && r->spi >= BENCH_MIN_RATIO * r->sent && r->p99_us <= BENCH_P99_MAX_US;
+}
+
+static void print_row(const bench_result_t *r, double seconds)
+{
+    printf("%6u %8u %7u %7u %7u %8.0f %6u %9u %7u %7u %7u %s\n",
+           r->queue_len, r->rate_hz, r->sent, r->rx, r->spi, r->spi / seconds,
+           r->drops, r->coalesced, r->p50_us, r->p99_us, r->max_us,
+           sustainable(r) ? "ok" : "-");
+}
+
+static int smoke(void)
+{
+    const double seconds = 0.5;
+    bench_result_t r;
+    if (run_forked(APP_QUEUE_LEN, 200, seconds, &r) < 0) {
+        fprintf(stderr, "smoke: bench child failed\n");
+        return 1;
+    }
+    print_row(&r, seconds);
+
+    /* Marge large : la machine de CI n’est pas temps réel */
+    if (r.sent == 0 || r.spi < 0.9 * r.sent || r.p99_us > 50000) {
+        fprintf(stderr, "smoke: %u/%u frames on SPI, p99=%u us\n", r.spi, r.sent, r.p99_us);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = BENCH_SECONDS;
+    unsigned only_queue = 0, only_rate = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--smoke")) return smoke();
+        else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--queue") && i + 1 < argc)   only_queue = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rate") && i + 1 < argc)    only_rate = (unsigned)atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--smoke] [--seconds S] [--queue N] [--rate HZ]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("UDP->SPI bridge, %s, SPI %u B @ 1 MHz (+%u us setup), %.1f s per case\n",
+           CONFIG_GP_UDP_DRAIN ? "drain" : "no drain", APP_SPI_FRAME_SIZE,
+           MOCK_SPI_SETUP_US, seconds);
+    printf("%6s %8s %7s %7s %7s %8s %6s %9s %7s %7s %7s\n",
+           "queue", "rate_hz", "sent", "rx", "spi", "spi_hz", "drops", "coalesced",
+           "p50_us", "p99_us", "max_us");
+
+    unsigned nq = only_queue ? 1 : COUNT(s_queues);
+    unsigned nr = only_rate  ? 1 : COUNT(s_rates);
+    for (unsigned qi = 0; qi < nq; ++qi) {
+        unsigned queue_len = only_queue ? only_queue : s_queues[qi];
+        unsigned best = 0;
+
+        for (unsigned ri = 0; ri < nr; ++ri) {
+            bench_result_t r;
+            if (run_forked(queue_len, only_rate ? only_rate : s_rates[ri], seconds, &r) < 0) {
+                fprintf(stderr, "bench child failed (queue=%u)\n", queue_len);
+                return 1;
+            }
+            print_row(&r, seconds);
+            if (sustainable(&r) && r.rate_hz > best) best = r.rate_hz;
+        }
+        printf("  queue=%u: max sustainable %u Hz (>= %.0f%% on SPI, p99 <= %u us)\n\n",
+               queue_len, best, BENCH_MIN_RATIO * 100, BENCH_P99_MAX_US);
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file    spi_master.h
+ * @brief   Build PC : maître SPI simulé (aucun bus, durée de transfert imitée).
+ *
+ * @project Projet immersif – ESP32
+ * @author  Hrithik SHEIKH
+ * @date    2025-09-15
+ *
+ * @details spi_device_transmit() dort le temps qu’aurait pris la trame sur le
+ *          fil (length / clock_speed_hz + MOCK_SPI_SETUP_US), puis appelle le
+ *          hook éventuel avec les horodatages de début et de fin. Le hook peut
+ *          remplir rx (ce que l’esclave aurait renvoyé sur MISO).
+ */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/* Préparation driver + DMA par transaction, estimée sur cible (µs) */
+#ifndef MOCK_SPI_SETUP_US
+  #define MOCK_SPI_SETUP_US  15
+#endif
+
+typedef enum { SPI1_HOST = 0, SPI2_HOST = 1, SPI3_HOST = 2 } spi_host_device_t;
+
+#define SPI_DMA_DISABLED  0
+#define SPI_DMA_CH_AUTO   3
+
+typedef struct {
+    int mosi_io_num;
+    int miso_io_num;
+    int sclk_io_num;
+    int quadwp_io_num;
+    int quadhd_io_num;
+    int max_transfer_sz;
+} spi_bus_config_t;
+
+typedef struct {
+    uint8_t  command_bits;
+    uint8_t  address_bits;
+    uint8_t  dummy_bits;
+    uint8_t  mode;
+    int      clock_speed_hz;
+    int      spics_io_num;
+    uint32_t flags;
+    int      queue_size;
+} spi_device_interface_config_t;
+
+typedef struct {
+    size_t      length;      /* bits */
+    size_t      rxlength;    /* bits */
+    const void *tx_buffer;
+    void       *rx_buffer;
+} spi_transaction_t;
+
+typedef struct mock_spi_dev *spi_device_handle_t;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *cfg, int dma_chan);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *cfg,
+                             spi_device_handle_t *out);
+esp_err_t spi_device_transmit(spi_device_handle_t dev, spi_transaction_t *t);
+
+/* Observation des transactions (banc de mesure) ; appelé dans la tâche émettrice */
+typedef void (*mock_spi_hook_t)(const uint8_t *tx, uint8_t *rx, size_t len,
+                                int64_t start_ns, int64_t end_ns);
+void mock_spi_set_hook(mock_spi_hook_t hook);
@@ -0,0 +1,11 @@
+/* Build PC : pas de RAM DMA dédiée, malloc() simple */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_DMA      (1u << 3)
+#define MALLOC_CAP_8BIT     (1u << 2)
+#define MALLOC_CAP_DEFAULT  (1u << 12)
+
+void *heap_caps_malloc(size_t size, uint32_t caps);
+void  heap_caps_free(void *ptr);
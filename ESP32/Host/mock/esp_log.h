@@ -0,0 +1,30 @@
+/* Build PC : logs IDF sur stderr, niveau global (le tag est ignoré) */
+#pragma once
+#include <stdint.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+extern esp_log_level_t mock_log_level;
+
+void     esp_log_level_set(const char *tag, esp_log_level_t level);
+uint32_t esp_log_timestamp(void);
+void     mock_log_write(esp_log_level_t level, const char *tag, const char *fmt, ...)
+             __attribute__((format(printf, 3, 4)));
+
+/* Niveau testé avant tout formatage : ULOGI par trame ne coûte rien si coupé */
+#define MOCK_LOG(level, tag, fmt, ...) do {                                  \
+        if ((level) <= mock_log_level) mock_log_write(level, tag, fmt, ##__VA_ARGS__); \
+    } while (0)
+
+#define ESP_LOGE(tag, fmt, ...)  MOCK_LOG(ESP_LOG_ERROR,   tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...)  MOCK_LOG(ESP_LOG_WARN,    tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...)  MOCK_LOG(ESP_LOG_INFO,    tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...)  MOCK_LOG(ESP_LOG_DEBUG,   tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...)  MOCK_LOG(ESP_LOG_VERBOSE, tag, fmt, ##__VA_ARGS__)
@@ -0,0 +1,5 @@
+/* Build PC : esp_timer_get_time() sur CLOCK_MONOTONIC (µs) */
+#pragma once
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
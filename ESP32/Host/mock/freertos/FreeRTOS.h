@@ -0,0 +1,38 @@
+/**
+ * @file    FreeRTOS.h
+ * @brief   Build PC : types et sections critiques FreeRTOS sur pthreads.
+ *
+ * @project Projet immersif – ESP32
+ * @author  Hrithik SHEIKH
+ * @date    2025-09-15
+ *
+ * @details Tick à 1 ms (la cible est à CONFIG_FREERTOS_HZ=100) pour que les
+ *          timeouts courts du pont restent mesurables sur PC. Les sections
+ *          critiques portMUX deviennent des mutex : même exclusion mutuelle,
+ *          sans le masquage d’IRQ.
+ */
+#pragma once
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdFALSE         0
+#define pdTRUE          1
+#define pdFAIL          pdFALSE
+#define pdPASS          pdTRUE
+#define portMAX_DELAY   ((TickType_t)0xffffffffu)
+
+#define configTICK_RATE_HZ  1000
+#define portTICK_PERIOD_MS  (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+
+#define configASSERT(x)     assert(x)
+
+typedef struct { pthread_mutex_t m; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED  { PTHREAD_MUTEX_INITIALIZER }
+#define portENTER_CRITICAL(mux)       pthread_mutex_lock(&(mux)->m)
+#define portEXIT_CRITICAL(mux)        pthread_mutex_unlock(&(mux)->m)
@@ -0,0 +1,11 @@
+/* Build PC : file FreeRTOS par copie, anneau protégé par mutex + condvar */
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef struct mock_queue *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void          vQueueDelete(QueueHandle_t q);
+BaseType_t    xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks);
+BaseType_t    xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks);
+UBaseType_t   uxQueueMessagesWaiting(QueueHandle_t q);
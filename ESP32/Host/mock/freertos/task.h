@@ -0,0 +1,16 @@
+/* Build PC : une tâche FreeRTOS = un thread POSIX (priorités ignorées, SCHED_OTHER) */
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef struct mock_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                       void *arg, UBaseType_t prio, TaskHandle_t *out);
+void       vTaskDelete(TaskHandle_t task);     /* NULL seulement : termine le thread appelant */
+void       vTaskDelay(TickType_t ticks);
+void       vTaskDelayUntil(TickType_t *prev_wake, TickType_t period);
+TickType_t xTaskGetTickCount(void);
+
+void       xTaskNotifyGive(TaskHandle_t task);
+uint32_t   ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
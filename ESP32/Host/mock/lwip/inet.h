@@ -0,0 +1,9 @@
+/* Build PC : inet_ntoa() & co de l’hôte, inet_ntoa_r() comme lwIP */
+#pragma once
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+static inline char *inet_ntoa_r(struct in_addr addr, char *buf, int buflen)
+{
+    return (char *)inet_ntop(AF_INET, &addr, buf, (socklen_t)buflen);
+}
@@ -0,0 +1,3 @@
+/* Build PC : résolution de noms de l’hôte */
+#pragma once
+#include <netdb.h>
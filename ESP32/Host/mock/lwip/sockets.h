@@ -0,0 +1,7 @@
+/* Build PC : sockets BSD de l’hôte à la place de lwIP */
+#pragma once
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
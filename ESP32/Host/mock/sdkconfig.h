@@ -0,0 +1,38 @@
+/**
+ * @file    sdkconfig.h
+ * @brief   Configuration du build PC (remplace le sdkconfig généré par l’IDF).
+ *
+ * @project Projet immersif – ESP32
+ * @author  Hrithik SHEIKH
+ * @date    2025-09-15
+ *
+ * @details Mêmes valeurs par défaut que main/Kconfig.projbuild, chacune
+ *          surchargeable par -D (options CMake de Host/CMakeLists.txt).
+ *          Le chemin raw lwIP (GP_UDP_RX_RAW) n’existe pas sur PC : seul le
+ *          chemin socket est compilé.
+ */
+#pragma once
+
+#ifndef CONFIG_GP_UDP_PORT
+  #define CONFIG_GP_UDP_PORT                 45555  /* pas 5555 : n’accroche pas l’appli PC */
+#endif
+#define CONFIG_GP_UDP_RX_RAW                 0
+#ifndef CONFIG_GP_UDP_DRAIN
+  #define CONFIG_GP_UDP_DRAIN                1
+#endif
+#define CONFIG_GP_WIFI_PROFILE_LOW_LATENCY   0
+#define CONFIG_GP_UDP_JITTER_STATS           0
+#ifndef CONFIG_GP_UDP_LOG_PACKETS
+  #define CONFIG_GP_UDP_LOG_PACKETS          0
+#endif
+#define CONFIG_GP_UDP_NOMINAL_PERIOD_MS      10
+#define CONFIG_LWIP_TCPIP_TASK_PRIO          18
+#ifndef CONFIG_GP_SESSION_ARBITRATION
+  #define CONFIG_GP_SESSION_ARBITRATION      0
+#endif
+#define CONFIG_GP_SESSION_OWNER_TIMEOUT_MS   500
+#define CONFIG_GP_SESSION_OWNER_MAX_HZ       250
+#define CONFIG_GP_SESSION_OTHER_MAX_HZ       20
+#define CONFIG_GP_TELEMETRY                  0
+#define CONFIG_GP_TELEMETRY_PERIOD_MS        500
+#define CONFIG_ESP_MAX_STA_CONN              4
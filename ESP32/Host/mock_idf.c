@@ -0,0 +1,268 @@
+/**
+ * @file    mock_idf.c
+ * @brief   Build PC : FreeRTOS (tâches, files, notifications), esp_timer,
+ *          esp_log, heap_caps et Wi-Fi minimal sur POSIX.
+ *
+ * @project Projet immersif – ESP32
+ * @author  Hrithik SHEIKH
+ * @date    2025-09-15
+ *
+ * @details Juste ce qu’utilisent udp_server.c, spi_link.c, session.c et
+ *          telemetry.c. Les tâches sont des pthreads ordonnancés par Linux :
+ *          les priorités FreeRTOS ne sont pas reproduites, les mesures
+ *          valent pour comparer des réglages entre eux, pas en absolu.
+ */
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "wifi_ap.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* ================================ horloge ================================ */
+static int64_t mono_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Échéance absolue CLOCK_MONOTONIC à now + ticks */
+static struct timespec deadline_after(TickType_t ticks)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t ns = ts.tv_nsec + (int64_t)ticks * (1000000000 / configTICK_RATE_HZ);
+    ts.tv_sec += ns / 1000000000;
+    ts.tv_nsec = ns % 1000000000;
+    return ts;
+}
+
+static void cond_init_mono(pthread_cond_t *c)
+{
+    pthread_condattr_t a;
+    pthread_condattr_init(&a);
+    pthread_condattr_setclock(&a, CLOCK_MONOTONIC);
+    pthread_cond_init(c, &a);
+    pthread_condattr_destroy(&a);
+}
+
+/* Attend c (m tenu) ; false au timeout. portMAX_DELAY = sans limite */
+static bool cond_wait_ticks(pthread_cond_t *c, pthread_mutex_t *m, const struct timespec *until)
+{
+    if (!until) return pthread_cond_wait(c, m) == 0;
+    return pthread_cond_timedwait(c, m, until) != ETIMEDOUT;
+}
+
+int64_t esp_timer_get_time(void) { return mono_us(); }
+
+/* ================================= tâches ================================ */
+struct mock_task {
+    pthread_t       thread;
+    TaskFunction_t  fn;
+    void           *arg;
+    pthread_mutex_t m;
+    pthread_cond_t  c;
+    uint32_t        notify;
+};
+
+static __thread struct mock_task *s_self = NULL;
+
+static void *task_entry(void *p)
+{
+    struct mock_task *t = p;
+    s_self = t;
+    t->fn(t->arg);
+    return NULL;    // une tâche FreeRTOS ne retourne pas ; toléré ici
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                       void *arg, UBaseType_t prio, TaskHandle_t *out)
+{
+    (void)name; (void)stack_depth; (void)prio;
+    struct mock_task *t = calloc(1, sizeof(*t));
+    if (!t) return pdFAIL;
+    t->fn  = fn;
+    t->arg = arg;
+    pthread_mutex_init(&t->m, NULL);
+    cond_init_mono(&t->c);
+
+    if (pthread_create(&t->thread, NULL, task_entry, t) != 0) {
+        free(t);
+        return pdFAIL;
+    }
+    pthread_detach(t->thread);
+    if (out) *out = t;
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    (void)task;     // NULL ou soi-même : seul usage du firmware
+    pthread_exit(NULL);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(mono_us() / (1000000 / configTICK_RATE_HZ));
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec until = deadline_after(ticks);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) == EINTR) { }
+}
+
+void vTaskDelayUntil(TickType_t *prev_wake, TickType_t period)
+{
+    *prev_wake += period;
+    int32_t left = (int32_t)(*prev_wake - xTaskGetTickCount());
+    if (left > 0) vTaskDelay((TickType_t)left);
+}
+
+void xTaskNotifyGive(TaskHandle_t task)
+{
+    pthread_mutex_lock(&task->m);
+    task->notify++;
+    pthread_cond_signal(&task->c);
+    pthread_mutex_unlock(&task->m);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks)
+{
+    struct mock_task *t = s_self;
+    assert(t != NULL);    // uniquement depuis une tâche créée par xTaskCreate
+    struct timespec until = deadline_after(ticks);
+
+    pthread_mutex_lock(&t->m);
+    while (t->notify == 0 && ticks != 0) {
+        if (!cond_wait_ticks(&t->c, &t->m, ticks == portMAX_DELAY ? NULL : &until)) break;
+    }
+    uint32_t v = t->notify;
+    if (v) t->notify = clear_on_exit ? 0 : v - 1;
+    pthread_mutex_unlock(&t->m);
+    return v;
+}
+
+/* ================================= files ================================= */
+struct mock_queue {
+    pthread_mutex_t m;
+    pthread_cond_t  not_empty, not_full;
+    UBaseType_t     len, item_size, head, count;
+    uint8_t        *buf;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    struct mock_queue *q = calloc(1, sizeof(*q));
+    if (!q) return NULL;
+    q->buf = malloc((size_t)length * item_size);
+    if (!q->buf) { free(q); return NULL; }
+    q->len = length;
+    q->item_size = item_size;
+    pthread_mutex_init(&q->m, NULL);
+    cond_init_mono(&q->not_empty);
+    cond_init_mono(&q->not_full);
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t q)
+{
+    if (!q) return;
+    pthread_mutex_destroy(&q->m);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->not_full);
+    free(q->buf);
+    free(q);
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks)
+{
+    struct timespec until = deadline_after(ticks);
+    pthread_mutex_lock(&q->m);
+    while (q->count == q->len) {
+        if (ticks == 0 || !cond_wait_ticks(&q->not_full, &q->m, ticks == portMAX_DELAY ? NULL : &until)) {
+            pthread_mutex_unlock(&q->m);
+            return pdFAIL;    // errQUEUE_FULL
+        }
+    }
+    UBaseType_t tail = (q->head + q->count) % q->len;
+    memcpy(q->buf + (size_t)tail * q->item_size, item, q->item_size);
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->m);
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks)
+{
+    struct timespec until = deadline_after(ticks);
+    pthread_mutex_lock(&q->m);
+    while (q->count == 0) {
+        if (ticks == 0 || !cond_wait_ticks(&q->not_empty, &q->m, ticks == portMAX_DELAY ? NULL : &until)) {
+            pthread_mutex_unlock(&q->m);
+            return pdFALSE;
+        }
+    }
+    memcpy(item, q->buf + (size_t)q->head * q->item_size, q->item_size);
+    q->head = (q->head + 1) % q->len;
+    q->count--;
+    pthread_cond_signal(&q->not_full);
+    pthread_mutex_unlock(&q->m);
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+    pthread_mutex_lock(&q->m);
+    UBaseType_t n = q->count;
+    pthread_mutex_unlock(&q->m);
+    return n;
+}
+
+/* ================================== logs ================================= */
+esp_log_level_t mock_log_level = ESP_LOG_INFO;
+static int64_t  s_log_t0_us;
+
+__attribute__((constructor)) static void log_t0_init(void) { s_log_t0_us = mono_us(); }
+
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    (void)tag;
+    mock_log_level = level;
+}
+
+uint32_t esp_log_timestamp(void) { return (uint32_t)((mono_us() - s_log_t0_us) / 1000); }
+
+void mock_log_write(esp_log_level_t level, const char *tag, const char *fmt, ...)
+{
+    static const char lv[] = "NEWIDV";
+    va_list ap;
+    va_start(ap, fmt);
+    flockfile(stderr);
+    fprintf(stderr, "%c (%" PRIu32 ") %s: ", lv[level], esp_log_timestamp(), tag);
+    vfprintf(stderr, fmt, ap);
+    fputc('\n', stderr);
+    funlockfile(stderr);
+    va_end(ap);
+}
+
+/* ================================ mémoire ================================ */
+void *heap_caps_malloc(size_t size, uint32_t caps) { (void)caps; return malloc(size); }
+void  heap_caps_free(void *ptr) { free(ptr); }
+
+/* ================================= Wi-Fi ================================= */
+/* Pas de SoftAP sur PC : une station fictive, pour telemetry.c */
+void wifi_ap_start(void) { }
+int  wifi_ap_get_sta_count(void) { return 1; }
+bool wifi_ap_get_sta_rssi(int8_t *rssi) { *rssi = -40; return true; }
@@ -0,0 +1,61 @@
+/**
+ * @file    mock_spi.c
+ * @brief   Build PC : maître SPI simulé pour spi_link.c (cf. driver/spi_master.h).
+ *
+ * @project Projet immersif – ESP32
+ * @author  Hrithik SHEIKH
+ * @date    2025-09-15
+ */
+#include "driver/spi_master.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+
+struct mock_spi_dev {
+    int clock_speed_hz;
+};
+
+static mock_spi_hook_t s_hook = NULL;
+
+static int64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *cfg, int dma_chan)
+{
+    (void)host; (void)dma_chan;
+    return (cfg && cfg->max_transfer_sz > 0) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *cfg,
+                             spi_device_handle_t *out)
+{
+    (void)host;
+    if (!cfg || cfg->clock_speed_hz <= 0 || !out) return ESP_ERR_INVALID_ARG;
+    struct mock_spi_dev *d = calloc(1, sizeof(*d));
+    if (!d) return ESP_ERR_NO_MEM;
+    d->clock_speed_hz = cfg->clock_speed_hz;
+    *out = d;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t dev, spi_transaction_t *t)
+{
+    if (!dev || !t || t->length == 0) return ESP_ERR_INVALID_ARG;
+
+    /* Durée sur le fil, puis attente absolue (pas de dérive sur les rafales) */
+    int64_t start = mono_ns();
+    int64_t wire  = (int64_t)t->length * 1000000000 / dev->clock_speed_hz;
+    int64_t end   = start + wire + (int64_t)MOCK_SPI_SETUP_US * 1000;
+    struct timespec until = { .tv_sec = end / 1000000000, .tv_nsec = end % 1000000000 };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) == EINTR) { }
+
+    if (s_hook) s_hook(t->tx_buffer, t->rx_buffer, t->length / 8, start, mono_ns());
+    return ESP_OK;
+}
+
+void mock_spi_set_hook(mock_spi_hook_t hook) { s_hook = hook; }
@@ -23,6 +23,7 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 
 #ifdef __cplusplus
@@ -73,6 +74,96 @@ typedef struct __attribute__((packed)) {
   _Static_assert(sizeof(gp_packet_t) == 28, "gp_packet_t must be 28 bytes");
 #endif
 
+/* ===================== Statut STM32 (MISO, SPI full-duplex) ============== */
+/*
+ * Bloc préchargé par le STM32 (CarStatus_t, car_status.h) et reçu par le
+ * maître dans la transaction qui envoie la commande suivante. L’esclave arme
+ * son DMA sur le front NSS : le bloc arrive décalé de quelques octets, on le
+ * retrouve par son magic.
+ */
+#define GP_CAR_STATUS_MAGIC 0x41545343u /* 'CSTA' sur le fil */
+
+#if defined(_MSC_VER)
+  #pragma pack(push, 1)
+#endif
+typedef struct __attribute__((packed)) {
+    uint32_t magic;         /* GP_CAR_STATUS_MAGIC */
+    uint16_t seq;           /* incrémenté à chaque bloc préparé */
+    uint16_t dir_duty;      /* dernier CCR direction appliqué */
+    uint16_t spd_duty;      /* dernier CCR vitesse appliqué */
+    uint8_t  lights;        /* feux (LIGHT_* côté STM32) */
+    uint8_t  cpu_load;      /* % hors idle, dernière seconde */
+    uint32_t rx_frames;     /* trames SPI reçues par le STM32 */
+    uint16_t rx_overruns;   /* trames perdues côté STM32 (file pleine) */
+    uint16_t spi_errors;    /* erreurs SPI côté esclave */
+} gp_car_status_t;
+#if defined(_MSC_VER)
+  #pragma pack(pop)
+#endif
+
+#ifdef __cplusplus
+  static_assert(sizeof(gp_car_status_t) == 20, "gp_car_status_t must be 20 bytes");
+#else
+  _Static_assert(sizeof(gp_car_status_t) == 20, "gp_car_status_t must be 20 bytes");
+#endif
+
+/* Cherche le bloc de statut dans une trame MISO ; false si absent (esclave
+   pas prêt, MISO flottant) */
+static inline bool gp_car_status_find(const uint8_t *frame, size_t len, gp_car_status_t *out)
+{
+    for (size_t off = 0; off + sizeof(*out) <= len; ++off) {
+        uint32_t magic;
+        memcpy(&magic, &frame[off], sizeof(magic));
+        if (magic == GP_CAR_STATUS_MAGIC) {
+            memcpy(out, &frame[off], sizeof(*out));
+            return true;
+        }
+    }
+    return false;
+}
+
+/* ======================= Télémétrie (ESP32 → PC) ========================= */
+/*
+ * Datagramme périodique renvoyé à l’adresse (ip:port) de la dernière trame
+ * manette reçue. Même conventions que gp_packet_t (LE, packed) ; la taille
+ * (56 o) et le magic le distinguent d’une trame de commande.
+ */
+#define GP_TELEM_MAGIC      0x4C455447u /* 'GTEL' sur le fil */
+
+enum {
+    GP_TELEM_RSSI_VALID  = 1u << 0,   /* rssi renseigné (station associée) */
+    GP_TELEM_STM32_VALID = 1u << 1,   /* car renseigné (bloc MISO reçu) */
+};
+
+#if defined(_MSC_VER)
+  #pragma pack(push, 1)
+#endif
+typedef struct __attribute__((packed)) {
+    uint32_t magic;         /* GP_TELEM_MAGIC */
+    uint8_t  version;       /* GP_PROTO_VERSION */
+    uint8_t  flags;         /* GP_TELEM_* */
+    int8_t   rssi;          /* dBm de la station */
+    uint8_t  sta_count;     /* stations associées */
+    uint32_t uptime_ms;
+    uint32_t seq;           /* numéro de datagramme télémétrie */
+    uint32_t rx_frames;     /* trames manette valides reçues */
+    uint32_t drops;         /* udp_drop_count() */
+    uint32_t coalesced;     /* udp_coalesced_count() */
+    uint32_t spi_errors;    /* transactions SPI en erreur */
+    uint16_t queue_depth;   /* udp_buffer_count() (raw : trame en attente, 0/1) */
+    uint16_t reserved;
+    gp_car_status_t car;    /* dernier statut STM32 (si GP_TELEM_STM32_VALID) */
+} gp_telemetry_t;
+#if defined(_MSC_VER)
+  #pragma pack(pop)
+#endif
+
+#ifdef __cplusplus
+  static_assert(sizeof(gp_telemetry_t) == 56, "gp_telemetry_t must be 56 bytes");
+#else
+  _Static_assert(sizeof(gp_telemetry_t) == 56, "gp_telemetry_t must be 56 bytes");
+#endif
+
 /* ============================= Helpers utiles ============================ */
 static inline void gp_packet_zero(gp_packet_t *p) { memset(p, 0, sizeof(*p)); }
 
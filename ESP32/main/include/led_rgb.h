@@ -1,15 +1,16 @@
 /**
  * @file    led_rgb.h
- * @brief   Pilotage d’un ruban/single LED RGB via le driver led_strip (RMT).
+ * @brief   LED RGB de statut (WS2812) pilotée directement par le RMT.
  *
  * @project Projet immersif – ESP32
  * @author  Hrithik SHEIKH
  * @date    2025-09-15
  *
  * @details
- *   - led_init(gpio): initialise le périphérique (1 LED adressable sur <gpio>)
- *                     et lance la tâche de clignotement de statut.
- *   - led_set_mode(m): change le mode (couleur) affiché de façon clignotante.
+ *   - led_init(gpio): initialise le canal RMT (1 LED adressable sur <gpio>)
+ *                     et pré-encode un motif de clignotement par mode.
+ *   - led_set_mode(m): si le mode change, lance son motif que le RMT rejoue
+ *                      seul en boucle (aucune tâche ni réveil CPU ensuite).
  */
 
 #pragma once
@@ -19,17 +20,18 @@
 typedef enum {
     LED_WIFI_DOWN = 0,   /**< Jaune clignotant */
     LED_AP_UP,           /**< Vert clignotant  */
-    LED_STA_CONNECTED    /**< Bleu clignotant  */
+    LED_STA_CONNECTED,   /**< Bleu clignotant  */
+    LED_MODE_COUNT
 } led_mode_t;
 
 /**
- * @brief   Initialise la LED RGB (1 LED) sur le GPIO donné et démarre la tâche.
+ * @brief   Initialise la LED RGB (1 LED) sur le GPIO donné (mode LED_WIFI_DOWN).
  * @param   gpio  Numéro de GPIO (ex: 8 sur ESP32-C3 DevKitC-02).
  */
 void led_init(int gpio);
 
 /**
- * @brief   Change le mode d’affichage (thread-safe).
+ * @brief   Change le mode d’affichage (thread-safe, sans effet si inchangé).
  * @param   m  Nouveau mode.
  */
 void led_set_mode(led_mode_t m);
@@ -0,0 +1,58 @@
+/**
+ * @file    session.h
+ * @brief   Table de sessions par source UDP et arbitrage du contrôleur.
+ *
+ * @project Projet immersif – ESP32
+ *
+ * @details
+ *   - Table de taille fixe (SESSION_SLOTS) indexée par hash de ip:port,
+ *     recherche en O(1) (sondage borné à la taille de la table).
+ *   - Par source : débit sur la dernière seconde, trames manquantes
+ *     (déduites des écarts > 1.5x CONFIG_GP_UDP_NOMINAL_PERIOD_MS, la trame
+ *     gp_packet_t n’ayant pas de numéro de séquence), trames limitées.
+ *   - Une seule source « propriétaire » pilote ; si elle se tait plus de
+ *     CONFIG_GP_SESSION_OWNER_TIMEOUT_MS, la prochaine source qui émet
+ *     prend la main.
+ *   - Seau à jetons par source : CONFIG_GP_SESSION_OWNER_MAX_HZ pour le
+ *     propriétaire, CONFIG_GP_SESSION_OTHER_MAX_HZ pour les autres ; le
+ *     surplus est rejeté avant toute copie vers le pont.
+ *   - session_admit() est appelée depuis l’unique contexte de réception
+ *     (udp_task ou thread tcpip) ; session_log() depuis n’importe quelle tâche.
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SESSION_FORWARD = 0,   /* propriétaire : trame à transmettre */
+    SESSION_IGNORED,       /* autre source, suivie mais non transmise */
+    SESSION_LIMITED,       /* débit dépassé (seau vide) */
+    SESSION_FULL,          /* table pleine, source inconnue */
+} session_verdict_t;
+
+/**
+ * @brief  Comptabilise une trame valide et décide si elle pilote la voiture.
+ * @param  addr   IPv4 source (ordre réseau).
+ * @param  port   Port source (ordre réseau).
+ * @param  now_us esp_timer_get_time() à la réception.
+ * @return Verdict (SESSION_FORWARD seulement pour le propriétaire).
+ */
+session_verdict_t session_admit(uint32_t addr, uint16_t port, int64_t now_us);
+
+/**
+ * @brief  Propriétaire courant.
+ * @return true si une source pilote (addr/port en ordre réseau).
+ */
+bool session_owner(uint32_t *addr, uint16_t *port);
+
+/** @brief Logue la table (source, débit, trous, limitées, propriétaire). */
+void session_log(void);
+
+#ifdef __cplusplus
+}
+#endif
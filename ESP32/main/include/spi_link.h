@@ -10,8 +10,11 @@
  *   - spi_link_init(): configure le bus SPI en mode esclave + broche HS.
  *   - spi_link_send(): copie une trame en TX, arme une transaction et attend
  *                      (jusqu’au timeout) que le maître la « clock ».
+ *                      Full-duplex : la trame MISO reçue dans la même
+ *                      transaction est lisible via spi_link_last_rx().
  *   - spi_link_poll(): variante non bloquante pour finaliser si besoin.
  *   - spi_link_busy(): indique si une transaction est en attente (HS=1).
+ *   - spi_link_error_count(): transactions en erreur depuis le démarrage.
  */
 
 #pragma once
@@ -45,12 +48,23 @@ esp_err_t spi_link_init(size_t frame_size,
  */
 esp_err_t spi_link_send(const void *data, size_t len, TickType_t timeout);
 
+/**
+ * @brief  Trame reçue sur MISO pendant le dernier spi_link_send() réussi.
+ * @param  len Sortie : taille de la trame (frame_size).
+ * @return Buffer interne, valide jusqu’au prochain spi_link_send()
+ *         (à lire depuis la tâche qui envoie).
+ */
+const uint8_t *spi_link_last_rx(size_t *len);
+
 /** @brief À appeler régulièrement si on ne veut pas bloquer. */
 void spi_link_poll(void);
 
 /** @brief Vrai si une transaction est en attente (HS=1). */
 bool spi_link_busy(void);
 
+/** @brief Nombre cumulé de transactions SPI en erreur (stat). */
+uint32_t spi_link_error_count(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,45 @@
+/**
+ * @file    telemetry.h
+ * @brief   Télémétrie périodique ESP32 → PC (santé du lien, sans câble série).
+ *
+ * @project Projet immersif – ESP32
+ *
+ * @details
+ *   - telemetry_start(): lance la tâche qui envoie un gp_telemetry_t toutes
+ *     les CONFIG_GP_TELEMETRY_PERIOD_MS à la dernière source manette connue.
+ *   - telemetry_note_peer(): appelée par le serveur UDP à chaque trame valide
+ *     pour mémoriser l’adresse de retour.
+ *   - telemetry_set_car_status(): dernier bloc de statut STM32 reçu sur MISO.
+ */
+
+#pragma once
+#include "esp_err.h"
+#include "gp_proto.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Démarre la tâche de télémétrie (socket d’émission dédiée).
+ * @return ESP_OK si OK, ESP_ERR_NO_MEM si la tâche n’a pas pu être créée.
+ */
+esp_err_t telemetry_start(void);
+
+/**
+ * @brief  Mémorise l’adresse de retour (ordre réseau, tel que reçu).
+ * @param  addr IPv4 de la source.
+ * @param  port Port UDP de la source.
+ */
+void telemetry_note_peer(uint32_t addr, uint16_t port);
+
+/**
+ * @brief  Dernier statut STM32 connu, recopié tel quel dans la télémétrie.
+ * @param  st Bloc reçu dans la trame MISO (gp_car_status_find()).
+ */
+void telemetry_set_car_status(const gp_car_status_t *st);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,10 +8,18 @@
  *
  * @details
  *   - udp_server_start(q): démarre les tâches UDP et pont UDP→SPI, en publiant
- *     chaque paquet décodé dans la queue fournie (élément = sizeof(gp_packet_t)).
+ *     chaque paquet décodé dans la queue fournie (élément = udp_rx_item_t :
+ *     trame + instant de réception, pour la latence réception → SPI).
+ *     Avec CONFIG_GP_UDP_RX_RAW, un callback lwIP raw remplace la tâche UDP
+ *     et alimente directement le pont (la queue reste vide).
  *   - udp_server_get_queue(): accès en lecture au handle interne (facultatif).
- *   - udp_buffer_count(): nombre d’éléments en attente dans la queue.
+ *   - udp_buffer_count(): nombre d’éléments en attente dans la queue
+ *     (chemin raw : 1 si une trame attend le pont, sinon 0).
  *   - udp_drop_count(): nombre de paquets dropés (stat).
+ *   - udp_rx_count(): trames manette valides reçues (stat).
+ *   - udp_coalesced_count(): trames remplacées par une plus récente avant
+ *     l’envoi SPI (chemin socket avec CONFIG_GP_UDP_DRAIN, et toujours sur
+ *     le chemin raw CONFIG_GP_UDP_RX_RAW).
  */
 
 #pragma once
@@ -19,10 +27,19 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include <stdint.h>  
+#include "sdkconfig.h"     // avant gp_proto.h : CONFIG_GP_UDP_PORT prime sur le fallback
+#include "gp_proto.h"
+
+/** Élément de la queue de réception : la trame et son instant de réception
+ *  (esp_timer, µs) : sortie de recvfrom, ou entrée du callback raw. */
+typedef struct {
+    gp_packet_t pkt;
+    int64_t     stamp_us;
+} udp_rx_item_t;
 
 /**
  * @brief Démarre le serveur UDP et le pont UDP→SPI.
- * @param rx_queue Queue de destination (élément = sizeof(gp_packet_t)).
+ * @param rx_queue Queue de destination (élément = sizeof(udp_rx_item_t)).
  * @return ESP_OK si OK, sinon un code d’erreur.
  */
 esp_err_t udp_server_start(QueueHandle_t rx_queue);
@@ -35,7 +52,8 @@ QueueHandle_t udp_server_get_queue(void);
 
 /**
  * @brief  Nombre de paquets en attente dans la queue.
- * @return Compteur d’éléments en file.
+ * @return Compteur d’éléments en file ; avec CONFIG_GP_UDP_RX_RAW, 1 si la
+ *         case "dernière trame" n’a pas encore été prise par le pont.
  */
 UBaseType_t udp_buffer_count(void);
 
@@ -44,3 +62,18 @@ UBaseType_t udp_buffer_count(void);
  * @return Compteur depuis le démarrage.
  */
 uint32_t udp_drop_count(void);
+
+/**
+ * @brief  Nombre cumulé de trames manette valides reçues (stat).
+ * @return Compteur depuis le démarrage.
+ */
+uint32_t udp_rx_count(void);
+
+/**
+ * @brief  Nombre cumulé de trames fusionnées (remplacées par une plus récente
+ *         de la même source avant d’atteindre le bus SPI).
+ * @return Compteur depuis le démarrage. Chemin socket : 0 si
+ *         CONFIG_GP_UDP_DRAIN=n ; chemin raw : compte toujours (une trame
+ *         arrivée avant que le pont ait pris la précédente la remplace).
+ */
+uint32_t udp_coalesced_count(void);
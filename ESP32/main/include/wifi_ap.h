@@ -9,9 +9,12 @@
  * @details
  *   - wifi_ap_start(): initialise la pile réseau, le Wi-Fi et lance le SoftAP.
  *   - wifi_ap_get_sta_count(): retourne le nombre de stations associées.
+ *   - wifi_ap_get_sta_rssi(): RSSI de la station la mieux reçue.
  */
 
 #pragma once
+#include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,6 +26,13 @@ void wifi_ap_start(void);
 /** Nombre courant de stations associées (best-effort). */
 int  wifi_ap_get_sta_count(void);
 
+/**
+ * @brief  RSSI (dBm) de la station associée la mieux reçue.
+ * @param  rssi Sortie, inchangée si aucune station.
+ * @return true si au moins une station est associée.
+ */
+bool wifi_ap_get_sta_rssi(int8_t *rssi);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,8 +1,8 @@
 #include "led_rgb.h"
 
-#include "led_strip.h"
+#include "driver/rmt_tx.h"
 #include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 
 /* Fallback si tu utilises tes macros ULOG* ailleurs */
@@ -12,85 +12,148 @@
   #define ULOGE  ESP_LOGE
 #endif
 
-/* ============================ état du module ============================= */
-static const char *TAG = "led";
-
-static led_strip_handle_t s_led = NULL;
-static volatile led_mode_t s_mode = LED_WIFI_DOWN;
+/* ============================ configuration ============================== */
+/*
+ * Chaque motif (trame couleur + attente ON + trame noire + attente OFF) est
+ * encodé une fois en symboles RMT au démarrage, puis rejoué par le RMT en
+ * boucle matérielle (loop_count = -1) : aucune tâche, aucun réveil CPU
+ * entre deux changements de mode.
+ *
+ * 2.5 MHz (0.4 us/tick) : bits WS2812 sur 3 ticks (0 = 1H+2L, 1 = 2H+1L),
+ * et un symbole peut couvrir 2 x 32767 ticks = 26 ms d'attente. Un motif
+ * 500/200 ms tient ainsi en ~80 symboles, dans 2 blocs mémoire RMT.
+ */
+#define LED_RMT_RES_HZ      (2500 * 1000)
+#define LED_RMT_MEM_SYMBOLS 96              /* 2 blocs de 48 (ESP32-C3) */
+#define LED_DUR_MAX         32767           /* champ duration 15 bits */
+#define LED_RESET_TICKS     250             /* 100 us bas avant chaque trame */
 
 /* Durées de blink par défaut (ms) */
 #define LED_ON_MS   500
 #define LED_OFF_MS  200
 
-/* ============================== helpers ================================== */
-static inline void set_rgb(uint8_t r, uint8_t g, uint8_t b)
+typedef struct {
+    uint8_t  r, g, b;
+    uint16_t on_ms;
+    uint16_t off_ms;    /* 0 = fixe, pas de boucle */
+} led_pattern_t;
+
+static const led_pattern_t s_patterns[LED_MODE_COUNT] = {
+    [LED_WIFI_DOWN]     = { 255, 180, 0,   LED_ON_MS, LED_OFF_MS },
+    [LED_AP_UP]         = { 0,   255, 255, LED_ON_MS, LED_OFF_MS },
+    [LED_STA_CONNECTED] = { 0,   255, 0,   LED_ON_MS, LED_OFF_MS },
+};
+
+/* ============================ état du module ============================= */
+static const char *TAG = "led";
+
+static rmt_channel_handle_t s_chan = NULL;
+static rmt_encoder_handle_t s_copy = NULL;
+static SemaphoreHandle_t    s_lock = NULL;
+static led_mode_t           s_mode = LED_MODE_COUNT;   /* aucun motif joué */
+
+static rmt_symbol_word_t s_sym[LED_MODE_COUNT][LED_RMT_MEM_SYMBOLS];
+static size_t            s_sym_len[LED_MODE_COUNT];
+
+/* ============================== encodage ================================= */
+static size_t put_low(rmt_symbol_word_t *s, uint32_t ticks)
 {
-    if (!s_led) return;
-    if (led_strip_set_pixel(s_led, 0, r, g, b) == ESP_OK) {
-        (void)led_strip_refresh(s_led);
+    /* n symboles de 2 demi-périodes basses égales (aucune durée nulle :
+       0 marquerait la fin de transmission) */
+    uint32_t n = (ticks + 2 * LED_DUR_MAX - 1) / (2 * LED_DUR_MAX);
+    uint32_t half = ticks / (2 * n);
+
+    for (uint32_t i = 0; i < n; i++) {
+        s[i] = (rmt_symbol_word_t){ .level0 = 0, .duration0 = half,
+                                    .level1 = 0, .duration1 = half };
     }
+    return n;
 }
 
-static inline void all_off(void)
+static size_t put_color(rmt_symbol_word_t *s, uint8_t r, uint8_t g, uint8_t b)
 {
-    if (!s_led) return;
-    (void)led_strip_clear(s_led);
-    (void)led_strip_refresh(s_led);
+    const uint8_t grb[3] = { g, r, b };
+    size_t n = 0;
+
+    n += put_low(&s[n], LED_RESET_TICKS);
+    for (int i = 0; i < 3; i++) {
+        for (int bit = 7; bit >= 0; bit--) {
+            int one = (grb[i] >> bit) & 1;
+            s[n++] = (rmt_symbol_word_t){ .level0 = 1, .duration0 = one ? 2 : 1,
+                                          .level1 = 0, .duration1 = one ? 1 : 2 };
+        }
+    }
+    return n;
 }
 
-/* ================================ tâche ================================== */
-static void led_task(void *arg)
+static size_t encode_pattern(const led_pattern_t *p, rmt_symbol_word_t *s)
 {
-    const TickType_t on_ticks  = pdMS_TO_TICKS(LED_ON_MS);
-    const TickType_t off_ticks = pdMS_TO_TICKS(LED_OFF_MS);
+    size_t n = put_color(s, p->r, p->g, p->b);
+    if (p->off_ms == 0) return n;
 
-    for (;;) {
-        uint8_t r = 0, g = 0, b = 0;
+    n += put_low(&s[n], (uint32_t)p->on_ms * (LED_RMT_RES_HZ / 1000));
+    n += put_color(&s[n], 0, 0, 0);
+    n += put_low(&s[n], (uint32_t)p->off_ms * (LED_RMT_RES_HZ / 1000));
+    return n;
+}
 
-        switch (s_mode) {
-            case LED_WIFI_DOWN:     r = 255; g = 180; b = 0;   break; 
-            case LED_AP_UP:         r = 0;   g = 255; b = 255;   break; 
-            case LED_STA_CONNECTED: r = 0;   g = 255; b = 0;   break;
-            default: break;
-        }
+/* Arrête le motif en cours et lance le nouveau (appelé sous s_lock) */
+static void play(led_mode_t m)
+{
+    rmt_transmit_config_t tx = {
+        .loop_count = s_patterns[m].off_ms ? -1 : 0,
+    };
 
-        set_rgb(r, g, b); vTaskDelay(on_ticks);
-        all_off();        vTaskDelay(off_ticks);
+    (void)rmt_disable(s_chan);   /* interrompt la boucle matérielle */
+    ESP_ERROR_CHECK(rmt_enable(s_chan));
+    if (rmt_transmit(s_chan, s_copy, s_sym[m], s_sym_len[m] * sizeof(rmt_symbol_word_t),
+                     &tx) != ESP_OK) {
+        ULOGE(TAG, "rmt_transmit() failed (mode=%d)", (int)m);
     }
 }
 
 /* ================================ API ==================================== */
 void led_set_mode(led_mode_t m)
 {
-    s_mode = m; /* suffisant ici : lecture/écriture atomiques sur enum */
+    if (!s_chan || m >= LED_MODE_COUNT) return;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (m != s_mode) {          /* re-programmation seulement sur changement */
+        s_mode = m;
+        play(m);
+    }
+    xSemaphoreGive(s_lock);
 }
 
 void led_init(int gpio)
 {
+    for (int m = 0; m < LED_MODE_COUNT; m++) {
+        s_sym_len[m] = encode_pattern(&s_patterns[m], s_sym[m]);
+        configASSERT(s_sym_len[m] <= LED_RMT_MEM_SYMBOLS);
+    }
 
-    led_strip_config_t strip_cfg = {
-        .strip_gpio_num = gpio,
-        .max_leds       = 1, 
-    };
-    led_strip_rmt_config_t rmt_cfg = {
+    rmt_tx_channel_config_t chan_cfg = {
+        .gpio_num          = gpio,
         .clk_src           = RMT_CLK_SRC_DEFAULT,
-        .resolution_hz     = 10 * 1000 * 1000, /* 10 MHz */
-        .mem_block_symbols = 0,
-        .flags = { .with_dma = false }
+        .resolution_hz     = LED_RMT_RES_HZ,
+        .mem_block_symbols = LED_RMT_MEM_SYMBOLS,  /* boucle : motif entier en RAM RMT */
+        .trans_queue_depth = 1,
     };
-
-    if (led_strip_new_rmt_device(&strip_cfg, &rmt_cfg, &s_led) != ESP_OK || !s_led) {
-        ULOGE(TAG, "led_strip_new_rmt_device() failed (gpio=%d)", gpio);
+    rmt_copy_encoder_config_t copy_cfg = {};
+
+    s_lock = xSemaphoreCreateMutex();
+    if (!s_lock ||
+        rmt_new_tx_channel(&chan_cfg, &s_chan) != ESP_OK ||
+        rmt_new_copy_encoder(&copy_cfg, &s_copy) != ESP_OK) {
+        ULOGE(TAG, "RMT init failed (gpio=%d)", gpio);
+        s_chan = NULL;
         return;
     }
+    ESP_ERROR_CHECK(rmt_enable(s_chan));
 
-    all_off();
-
-    if (xTaskCreate(led_task, "led_task", 2048, NULL, 3, NULL) != pdPASS) {
-        ULOGE(TAG, "xTaskCreate(led_task) failed");
-        return;
-    }
+    led_set_mode(LED_WIFI_DOWN);
 
-    ULOGI(TAG, "LED ready on GPIO%d", gpio);
+    ULOGI(TAG, "LED ready on GPIO%d (RMT loop, %u/%u/%u symbols)", gpio,
+          (unsigned)s_sym_len[LED_WIFI_DOWN], (unsigned)s_sym_len[LED_AP_UP],
+          (unsigned)s_sym_len[LED_STA_CONNECTED]);
 }
-
@@ -10,6 +10,7 @@
 #include "wifi_ap.h"
 #include "spi_link.h"
 #include "udp_server.h"
+#include "telemetry.h"
 #include "gp_proto.h" 
 
 #if CONFIG_USER_UART_ENABLE
@@ -66,7 +67,7 @@ void app_main(void)
     ULOGI("spi", "SPI link ready (frame=%u)", (unsigned)APP_SPI_FRAME_SIZE);
 
     /* ---- File de messages UDP ---- */
-    QueueHandle_t q = xQueueCreate(APP_QUEUE_LEN, sizeof(gp_packet_t));
+    QueueHandle_t q = xQueueCreate(APP_QUEUE_LEN, sizeof(udp_rx_item_t));
     configASSERT(q != NULL);
     ULOGI("queue", "Queue created (%u elts)", (unsigned)APP_QUEUE_LEN);
 
@@ -74,4 +75,9 @@ void app_main(void)
     udp_server_start(q); 
     ULOGI("udp", "UDP server up");
 
+#if CONFIG_GP_TELEMETRY
+    /* ---- Télémétrie vers le PC ---- */
+    telemetry_start();
+#endif
+
 }
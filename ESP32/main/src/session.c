@@ -0,0 +1,184 @@
+#include "session.h"
+
+#include "sdkconfig.h"
+#include "esp_log.h"
+
+#include "lwip/sockets.h"
+#include "lwip/inet.h"
+
+#include "freertos/FreeRTOS.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#ifndef ULOGI
+  #define ULOGI  ESP_LOGI
+  #define ULOGW  ESP_LOGW
+  #define ULOGE  ESP_LOGE
+#endif
+
+/* ============================ configuration ============================== */
+#define SESSION_SLOTS       8                   // puissance de 2, >= 2 x CONFIG_ESP_MAX_STA_CONN
+#define SESSION_BURST       8                   // trames d'avance (rafales après agrégation Wi-Fi)
+#define SESSION_WINDOW_US   (1000 * 1000)       // fenêtre de mesure du débit
+#define SESSION_IDLE_US     (5 * 1000 * 1000)   // slot réutilisable après 5 s de silence
+#define SESSION_NOMINAL_US  ((int64_t)CONFIG_GP_UDP_NOMINAL_PERIOD_MS * 1000)
+#define SESSION_OWNER_TIMEOUT_US ((int64_t)CONFIG_GP_SESSION_OWNER_TIMEOUT_MS * 1000)
+#define SESSION_TOKEN       1000000             // coût d'une trame (jetons en trame·µs/s)
+
+_Static_assert((SESSION_SLOTS & (SESSION_SLOTS - 1)) == 0, "SESSION_SLOTS must be a power of 2");
+_Static_assert(SESSION_SLOTS >= 2 * CONFIG_ESP_MAX_STA_CONN, "SESSION_SLOTS too small for ESP_MAX_STA_CONN");
+
+typedef struct {
+    bool     used;
+    uint32_t addr;          // ordre réseau
+    uint16_t port;          // ordre réseau
+    int64_t  last_us;
+    int64_t  tokens;        // seau à jetons, SESSION_TOKEN par trame
+    int64_t  win_start_us;
+    uint32_t win_frames;
+    uint32_t rate_hz;       // trames sur la dernière fenêtre complète
+    uint32_t frames;
+    uint32_t gaps;          // trames manquantes estimées
+    uint32_t limited;
+} session_t;
+
+/* ============================ état du module ============================= */
+static const char *TAG = "session";
+
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static session_t    s_tab[SESSION_SLOTS];
+static int          s_owner = -1;
+
+/* ================================ helpers ================================ */
+static inline uint32_t slot_hash(uint32_t addr, uint16_t port)
+{
+    /* hash multiplicatif : les log2(SESSION_SLOTS) bits de poids fort */
+    return ((addr ^ ((uint32_t)port << 16)) * 2654435761u) >> (32 - __builtin_ctz(SESSION_SLOTS));
+}
+
+/* Slot de la source, ou slot libre/expiré pour l'accueillir, -1 si table pleine */
+static int slot_find(uint32_t addr, uint16_t port, int64_t now)
+{
+    int spare = -1;
+    uint32_t h = slot_hash(addr, port);
+
+    for (uint32_t i = 0; i < SESSION_SLOTS; ++i) {
+        int k = (int)((h + i) & (SESSION_SLOTS - 1));
+        session_t *s = &s_tab[k];
+        if (s->used && s->addr == addr && s->port == port) return k;
+        if (spare < 0 && (!s->used || (k != s_owner && now - s->last_us > SESSION_IDLE_US))) {
+            spare = k;
+        }
+    }
+    if (spare >= 0) {
+        s_tab[spare] = (session_t){
+            .used = true, .addr = addr, .port = port,
+            .last_us = now, .win_start_us = now,
+            .tokens = (int64_t)SESSION_BURST * SESSION_TOKEN,
+        };
+    }
+    return spare;
+}
+
+static void session_account(session_t *s, int64_t now)
+{
+    int64_t dt = now - s->last_us;
+    if (s->frames && dt > SESSION_NOMINAL_US + SESSION_NOMINAL_US / 2) {
+        s->gaps += (uint32_t)((dt + SESSION_NOMINAL_US / 2) / SESSION_NOMINAL_US) - 1;
+    }
+    s->frames++;
+    s->last_us = now;
+
+    if (now - s->win_start_us >= SESSION_WINDOW_US) {
+        s->rate_hz = s->win_frames;
+        s->win_frames = 0;
+        s->win_start_us = now;
+    }
+    s->win_frames++;
+}
+
+static bool session_take_token(session_t *s, int64_t dt, uint32_t max_hz)
+{
+    const int64_t cap = (int64_t)SESSION_BURST * SESSION_TOKEN;
+    s->tokens += dt * max_hz;
+    if (s->tokens > cap) s->tokens = cap;
+    if (s->tokens < SESSION_TOKEN) return false;
+    s->tokens -= SESSION_TOKEN;
+    return true;
+}
+
+/* ================================== API ================================== */
+session_verdict_t session_admit(uint32_t addr, uint16_t port, int64_t now_us)
+{
+    session_verdict_t v;
+    int prev_owner;
+
+    portENTER_CRITICAL(&s_mux);
+    prev_owner = s_owner;
+    int k = slot_find(addr, port, now_us);
+    if (k < 0) {
+        v = SESSION_FULL;
+    } else {
+        session_t *s = &s_tab[k];
+        int64_t dt = now_us - s->last_us;
+
+        /* Propriétaire muet trop longtemps → la source qui parle prend la main */
+        if (s_owner < 0 || (s_owner != k && now_us - s_tab[s_owner].last_us > SESSION_OWNER_TIMEOUT_US)) {
+            s_owner = k;
+        }
+
+        uint32_t max_hz = (k == s_owner) ? CONFIG_GP_SESSION_OWNER_MAX_HZ : CONFIG_GP_SESSION_OTHER_MAX_HZ;
+        if (!session_take_token(s, dt, max_hz)) {
+            s->limited++;
+            s->last_us = now_us;    // reste vivante, mais rien ne passe
+            v = SESSION_LIMITED;
+        } else {
+            session_account(s, now_us);
+            v = (k == s_owner) ? SESSION_FORWARD : SESSION_IGNORED;
+        }
+    }
+    int owner = s_owner;
+    portEXIT_CRITICAL(&s_mux);
+
+    if (owner != prev_owner) {
+        struct in_addr ia = { .s_addr = addr };
+        char ip[INET_ADDRSTRLEN];   // inet_ntoa() : tampon statique partagé entre tâches
+        ULOGI(TAG, "owner -> %s:%d (%s)", inet_ntoa_r(ia, ip, sizeof(ip)), ntohs(port),
+              prev_owner < 0 ? "first controller" : "handover after timeout");
+    }
+    return v;
+}
+
+bool session_owner(uint32_t *addr, uint16_t *port)
+{
+    bool ok;
+    portENTER_CRITICAL(&s_mux);
+    ok = (s_owner >= 0);
+    if (ok) {
+        *addr = s_tab[s_owner].addr;
+        *port = s_tab[s_owner].port;
+    }
+    portEXIT_CRITICAL(&s_mux);
+    return ok;
+}
+
+void session_log(void)
+{
+    session_t tab[SESSION_SLOTS];
+    int owner;
+
+    portENTER_CRITICAL(&s_mux);
+    memcpy(tab, s_tab, sizeof(tab));
+    owner = s_owner;
+    portEXIT_CRITICAL(&s_mux);
+
+    for (int k = 0; k < SESSION_SLOTS; ++k) {
+        if (!tab[k].used) continue;
+        struct in_addr ia = { .s_addr = tab[k].addr };
+        char ip[INET_ADDRSTRLEN];
+        ULOGI(TAG, "%c %s:%d rate=%" PRIu32 " Hz frames=%" PRIu32 " gaps=%" PRIu32 " limited=%" PRIu32,
+              k == owner ? '*' : ' ', inet_ntoa_r(ia, ip, sizeof(ip)), ntohs(tab[k].port),
+              tab[k].rate_hz, tab[k].frames, tab[k].gaps, tab[k].limited);
+    }
+}
@@ -17,6 +17,8 @@ static spi_device_handle_t s_dev = NULL;
 
 static size_t   s_frame_sz = 0;
 static uint8_t *s_txbuf    = NULL;
+static uint8_t *s_rxbuf    = NULL;   // MISO : statut STM32 (gp_car_status_t)
+static volatile uint32_t s_err_cnt = 0;
 
 esp_err_t spi_link_init(size_t frame_size,
                         int mosi, int miso, int sclk, int cs)
@@ -38,7 +40,7 @@ esp_err_t spi_link_init(size_t frame_size,
         .mode = 0,                         // CPOL=0, CPHA=0
         .spics_io_num = cs,
         .queue_size = 2,
-        .flags = SPI_DEVICE_HALFDUPLEX,
+        .flags = 0,                        // full-duplex : MISO porte le statut STM32
         .command_bits = 0,
         .address_bits = 0,
         .dummy_bits = 0,
@@ -46,8 +48,10 @@ esp_err_t spi_link_init(size_t frame_size,
     ESP_ERROR_CHECK(spi_bus_add_device(s_host, &devcfg, &s_dev));
 
     s_txbuf = (uint8_t*)heap_caps_malloc(frame_size, MALLOC_CAP_DMA);
-    if (!s_txbuf) return ESP_ERR_NO_MEM;
+    s_rxbuf = (uint8_t*)heap_caps_malloc(frame_size, MALLOC_CAP_DMA);
+    if (!s_txbuf || !s_rxbuf) return ESP_ERR_NO_MEM;
     memset(s_txbuf, 0, frame_size);
+    memset(s_rxbuf, 0, frame_size);
 
     ULOGI(TAG, "SPI MASTER ready (frame=%u, MOSI=%d MISO=%d SCLK=%d CS=%d)",
           (unsigned)frame_size, mosi, miso, sclk, cs);
@@ -65,13 +69,24 @@ esp_err_t spi_link_send(const void *data, size_t len, TickType_t timeout)
 
     spi_transaction_t t = {
         .length   = s_frame_sz * 8, // bits
+        .rxlength = s_frame_sz * 8,
         .tx_buffer = s_txbuf,
-        .rx_buffer = NULL
+        .rx_buffer = s_rxbuf
     };
     esp_err_t r = spi_device_transmit(s_dev, &t);
-    if (r != ESP_OK) ULOGW(TAG, "transmit err=%d", r);
+    if (r != ESP_OK) {
+        s_err_cnt++;
+        ULOGW(TAG, "transmit err=%d", r);
+    }
     return r;
 }
 
+const uint8_t *spi_link_last_rx(size_t *len)
+{
+    if (len) *len = s_frame_sz;
+    return s_rxbuf;
+}
+
 void spi_link_poll(void) { /* no-op en maître */ }
 bool spi_link_busy(void) { return false; }
+uint32_t spi_link_error_count(void) { return s_err_cnt; }
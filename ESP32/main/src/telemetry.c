@@ -0,0 +1,131 @@
+#include "telemetry.h"
+
+#include "sdkconfig.h"
+
+#include "gp_proto.h"
+#include "udp_server.h"
+#include "spi_link.h"
+#include "wifi_ap.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "lwip/sockets.h"
+#include "lwip/inet.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#ifndef ULOGI
+  #define ULOGI  ESP_LOGI
+  #define ULOGW  ESP_LOGW
+  #define ULOGE  ESP_LOGE
+#endif
+
+/* ============================ configuration ============================== */
+#ifndef CONFIG_GP_TELEMETRY_PERIOD_MS
+  #define CONFIG_GP_TELEMETRY_PERIOD_MS  500
+#endif
+#define TELEM_PEER_TIMEOUT_US  (2 * 1000 * 1000)   // plus de trame depuis 2 s → silence
+
+/* ============================ état du module ============================= */
+static const char *TAG = "telem";
+
+static portMUX_TYPE      s_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t          s_peer_addr = 0;      // ordre réseau
+static uint16_t          s_peer_port = 0;      // ordre réseau
+static int64_t           s_peer_seen_us = 0;
+static gp_car_status_t   s_car;                // sous s_mux
+static bool              s_car_valid = false;
+
+/* ================================ helpers ================================ */
+static void telemetry_fill(gp_telemetry_t *t, uint32_t seq)
+{
+    memset(t, 0, sizeof(*t));
+    t->magic       = GP_TELEM_MAGIC;
+    t->version     = GP_PROTO_VERSION;
+    t->sta_count   = (uint8_t)wifi_ap_get_sta_count();
+    t->uptime_ms   = (uint32_t)(esp_timer_get_time() / 1000);
+    t->seq         = seq;
+    t->rx_frames   = udp_rx_count();
+    t->drops       = udp_drop_count();
+    t->coalesced   = udp_coalesced_count();
+    t->spi_errors  = spi_link_error_count();
+    t->queue_depth = (uint16_t)udp_buffer_count();
+
+    if (wifi_ap_get_sta_rssi(&t->rssi)) t->flags |= GP_TELEM_RSSI_VALID;
+    portENTER_CRITICAL(&s_mux);
+    if (s_car_valid) {
+        t->car = s_car;
+        t->flags |= GP_TELEM_STM32_VALID;
+    }
+    portEXIT_CRITICAL(&s_mux);
+}
+
+/* ================================= tâche ================================= */
+static void telemetry_task(void *arg)
+{
+    /* Socket d'émission à part : pas de partage avec le chemin de réception
+       (socket ou lwIP raw). Le PC reçoit sur son socket d'envoi, qui accepte
+       toute source tant qu'il n'est pas connect(). */
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    if (sock < 0) {
+        ULOGE(TAG, "socket() failed");
+        vTaskDelete(NULL);
+        return;
+    }
+
+    uint32_t seq = 0;
+    TickType_t last = xTaskGetTickCount();
+    for (;;) {
+        vTaskDelayUntil(&last, pdMS_TO_TICKS(CONFIG_GP_TELEMETRY_PERIOD_MS));
+
+        portENTER_CRITICAL(&s_mux);
+        struct sockaddr_in dst = {
+            .sin_family = AF_INET,
+            .sin_port   = s_peer_port,
+            .sin_addr.s_addr = s_peer_addr,
+        };
+        int64_t seen = s_peer_seen_us;
+        portEXIT_CRITICAL(&s_mux);
+
+        if (seen == 0 || esp_timer_get_time() - seen > TELEM_PEER_TIMEOUT_US) continue;
+
+        gp_telemetry_t t;
+        telemetry_fill(&t, seq++);
+        if (sendto(sock, &t, sizeof(t), 0, (struct sockaddr*)&dst, sizeof(dst)) < 0) {
+            ULOGW(TAG, "sendto(%s:%d) failed", inet_ntoa(dst.sin_addr), ntohs(dst.sin_port));
+        }
+    }
+}
+
+/* ============================== API publique ============================= */
+esp_err_t telemetry_start(void)
+{
+    if (xTaskCreate(telemetry_task, "telemetry", 3072, NULL, 3, NULL) != pdPASS) {
+        ULOGE(TAG, "task creation failed");
+        return ESP_ERR_NO_MEM;
+    }
+    ULOGI(TAG, "telemetry every %d ms to last controller source", CONFIG_GP_TELEMETRY_PERIOD_MS);
+    return ESP_OK;
+}
+
+void telemetry_note_peer(uint32_t addr, uint16_t port)
+{
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_mux);
+    s_peer_addr = addr;
+    s_peer_port = port;
+    s_peer_seen_us = now;
+    portEXIT_CRITICAL(&s_mux);
+}
+
+void telemetry_set_car_status(const gp_car_status_t *st)
+{
+    portENTER_CRITICAL(&s_mux);
+    s_car = *st;
+    s_car_valid = true;
+    portEXIT_CRITICAL(&s_mux);
+}
@@ -1,19 +1,34 @@
 #include "udp_server.h"
 
+#include "sdkconfig.h"
+
 #include "gp_proto.h"
 #include "user_log_setup.h"
 #include "spi_link.h"
+#include "telemetry.h"
+#if CONFIG_GP_SESSION_ARBITRATION
+#include "session.h"
+#endif
 #include "esp_log.h" 
+#include "esp_timer.h"
 
 #include "lwip/sockets.h"
 #include "lwip/inet.h"
 #include "lwip/netdb.h"
+#if CONFIG_GP_UDP_RX_RAW
+#include "lwip/udp.h"
+#include "lwip/pbuf.h"
+#include "lwip/tcpip.h"
+#endif
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
 #include <string.h>
 #include <inttypes.h>
+#if CONFIG_GP_UDP_JITTER_STATS
+#include <math.h>
+#endif
   
 #ifndef ULOGI
   #define ULOGI  ESP_LOGI
@@ -26,9 +41,77 @@
 static const char *TAG = "udp";
 static QueueHandle_t s_rx_q = NULL;       // queue interne (remplace l’ex- s_q)
 static volatile uint32_t s_drop_cnt = 0;  // stats: paquets dropés
+static volatile uint32_t s_rx_cnt = 0;    // stats: trames valides reçues
+static volatile uint32_t s_coalesced_cnt = 0; // stats: trames remplacées par une plus récente
+
+/* Latence réception → départ SPI (esp_timer, µs), loguée tous les UDP_LAT_WINDOW */
+#define UDP_LAT_WINDOW  1000
+#if CONFIG_GP_UDP_RX_RAW
+  #define UDP_RX_PATH_NAME "raw"
+#else
+  #define UDP_RX_PATH_NAME "socket"
+#endif
+static uint32_t s_lat_n = 0, s_lat_max_us = 0;
+static uint64_t s_lat_sum_us = 0;
+
+/*
+ * Priorités : profil low-latency → réception et pont juste sous le thread
+ * tcpip (lui-même sous la tâche Wi-Fi), pour qu'aucune tâche applicative ne
+ * s'intercale entre l'arrivée radio et le départ SPI. Le pont reste au-dessus
+ * de udp_task pour consommer la queue dès qu'une trame y est posée.
+ */
+#if CONFIG_GP_WIFI_PROFILE_LOW_LATENCY
+  #define UDP_TASK_PRIO     (CONFIG_LWIP_TCPIP_TASK_PRIO - 2)
+  #define BRIDGE_TASK_PRIO  (CONFIG_LWIP_TCPIP_TASK_PRIO - 1)
+  #define WIFI_PROFILE_NAME "low-latency"
+#else
+  #define UDP_TASK_PRIO     5
+  #define BRIDGE_TASK_PRIO  6
+  #define WIFI_PROFILE_NAME "default"
+#endif
+
+#if CONFIG_GP_UDP_JITTER_STATS
+/* Inter-arrivée des trames valides (µs), fenêtre de UDP_LAT_WINDOW écarts */
+typedef struct {
+    uint32_t n, late, min_us, max_us;
+    uint64_t sum_us, sum_sq;
+} udp_jitter_t;
+
+#define UDP_NOMINAL_US  (CONFIG_GP_UDP_NOMINAL_PERIOD_MS * 1000)
+static int64_t       s_jit_last_us = 0;      // écrit par le seul contexte de réception
+static udp_jitter_t  s_jit;                  // fenêtre en cours
+static udp_jitter_t  s_jit_ready;            // fenêtre complète, loguée par le pont
+static bool          s_jit_has_ready = false;
+static portMUX_TYPE  s_jit_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+#if CONFIG_GP_UDP_RX_RAW
+/* Chemin raw : une seule case "dernière trame", lue par le pont */
+static portMUX_TYPE  s_raw_mux = portMUX_INITIALIZER_UNLOCKED;
+static gp_packet_t   s_raw_latest;
+static int64_t       s_raw_stamp_us;         // entrée du callback pour s_raw_latest
+static bool          s_raw_pending = false;
+static TaskHandle_t  s_bridge_task = NULL;
+#endif
+
+#if CONFIG_GP_UDP_DRAIN
+#define UDP_DRAIN_SOURCES  4    // sources (ip:port) suivies par passe de drain
+#define UDP_DRAIN_MAX      32   // datagrammes max par passe (évite la famine sous flood)
+
+/* Dernière trame valide d'une source pendant une passe de drain */
+typedef struct {
+    bool        used;
+    uint32_t    addr;
+    uint16_t    port;
+    int64_t     stamp_us;   // réception de pkt (sortie de recvfrom)
+    gp_packet_t pkt;
+} udp_latest_t;
+#endif
 
 /* =========================== protos internes ============================= */
+#if !CONFIG_GP_UDP_RX_RAW
 static void udp_task(void *arg);
+#endif
 static void bridge_udp_to_spi_task(void *arg);
 
 static inline void bin32(uint32_t v, char out[33]) {
@@ -50,6 +133,7 @@ static inline void log_buffer_bin(const char *tag, const uint8_t *buf, int len)
     }
 }
 
+#if CONFIG_GP_UDP_LOG_PACKETS
 static void gp_log_packet(const gp_packet_t *p)
 {
     char b_btn[33];
@@ -62,27 +146,216 @@ static void gp_log_packet(const gp_packet_t *p)
           p->rx, p->ry,
           p->lt, p->rt);
 }
+#else
+static inline void gp_log_packet(const gp_packet_t *p) { (void)p; }
+#endif
 
-/* ASCII "0101…" → gp_packet_t (boutons). Retourne false si non conforme. */
-static bool parse_ascii_01_to_packet(const uint8_t *buf, int len, gp_packet_t *out) {
-    int bits = 0; uint32_t acc = 0;
-    for (int i = 0; i < len; ++i) {
-        char c = (char)buf[i];
-        if (c == '\r' || c == '\n' || c == ' ') continue;
-        if (c != '0' && c != '1') return false;
-        if (bits < 32) { acc = (acc << 1) | (uint32_t)(c == '1'); bits++; }
+#if CONFIG_GP_UDP_JITTER_STATS
+/* Appelé à chaque trame valide, dans le contexte de réception (tcpip ou udp_task) */
+static void jitter_sample(int64_t now)
+{
+    int64_t last = s_jit_last_us;
+    s_jit_last_us = now;
+    if (last == 0) return;
+
+    uint32_t dt = (uint32_t)(now - last);
+    if (s_jit.n == 0 || dt < s_jit.min_us) s_jit.min_us = dt;
+    if (dt > s_jit.max_us) s_jit.max_us = dt;
+    if (dt > 2u * UDP_NOMINAL_US) s_jit.late++;
+    s_jit.sum_us += dt;
+    s_jit.sum_sq += (uint64_t)dt * dt;
+
+    if (++s_jit.n == UDP_LAT_WINDOW) {
+        portENTER_CRITICAL(&s_jit_mux);
+        s_jit_ready = s_jit;
+        s_jit_has_ready = true;
+        portEXIT_CRITICAL(&s_jit_mux);
+        memset(&s_jit, 0, sizeof(s_jit));
     }
-    if (bits == 0) return false;
-    if (bits < 32) acc <<= (32 - bits); // left-pad si moins de 32 bits
-    memset(out, 0, sizeof(*out));
-    out->buttons = acc;
+}
+
+/* Côté pont : logue la dernière fenêtre complète (pas de printf en tcpip) */
+static void jitter_report(void)
+{
+    udp_jitter_t j;
+    portENTER_CRITICAL(&s_jit_mux);
+    bool ok = s_jit_has_ready;
+    j = s_jit_ready;
+    s_jit_has_ready = false;
+    portEXIT_CRITICAL(&s_jit_mux);
+    if (!ok) return;
+
+    double mean = (double)j.sum_us / j.n;
+    double var  = (double)j.sum_sq / j.n - mean * mean;
+    ULOGI(TAG, "rx jitter (%s/%s) n=%u mean=%u us std=%u us min=%u max=%u us late(>%u us)=%u",
+          WIFI_PROFILE_NAME, UDP_RX_PATH_NAME, (unsigned)j.n, (unsigned)mean,
+          (unsigned)sqrt(var > 0 ? var : 0), (unsigned)j.min_us, (unsigned)j.max_us,
+          (unsigned)(2u * UDP_NOMINAL_US), (unsigned)j.late);
+}
+#else
+static inline void jitter_sample(int64_t now) { (void)now; }
+static inline void jitter_report(void) { }
+#endif
+
+/* Arbitrage : seule la source propriétaire pilote (cf. session.h) */
+static inline bool rx_admit(uint32_t addr, uint16_t port, int64_t now)
+{
+#if CONFIG_GP_SESSION_ARBITRATION
+    return session_admit(addr, port, now) == SESSION_FORWARD;
+#else
+    (void)addr; (void)port; (void)now;
     return true;
+#endif
+}
+
+#if CONFIG_GP_UDP_RX_RAW
+/*
+ * Callback lwIP (thread tcpip) : validation directement dans le pbuf, une
+ * seule copie vers la case du pont puis notification. Pas de socket, pas de
+ * mailbox, pas de tâche UDP intermédiaire.
+ */
+static void udp_raw_recv(void *arg, struct udp_pcb *pcb, struct pbuf *pb,
+                         const ip_addr_t *addr, u16_t port)
+{
+    if (pb->tot_len == sizeof(gp_packet_t)) {
+        int64_t  now      = esp_timer_get_time();
+        uint32_t src_addr = ip4_addr_get_u32(ip_2_ip4(addr));
+        uint16_t src_port = lwip_htons(port);
+
+        s_rx_cnt++;
+        if (!rx_admit(src_addr, src_port, now)) {
+            pbuf_free(pb);
+            return;
+        }
+
+        gp_packet_t tmp;
+        const gp_packet_t *in = (const gp_packet_t *)pb->payload;   // packed : pas d'alignement requis
+        if (pb->len < sizeof(gp_packet_t)) {                         // pbuf chaîné (rare)
+            pbuf_copy_partial(pb, &tmp, sizeof(tmp), 0);
+            in = &tmp;
+        }
+        jitter_sample(now);
+        telemetry_note_peer(src_addr, src_port);
+
+        portENTER_CRITICAL(&s_raw_mux);
+        if (s_raw_pending) s_coalesced_cnt++;
+        s_raw_latest   = *in;
+        s_raw_stamp_us = now;
+        s_raw_pending  = true;
+        portEXIT_CRITICAL(&s_raw_mux);
+
+        if (s_bridge_task) xTaskNotifyGive(s_bridge_task);
+    }
+    pbuf_free(pb);
+}
+
+/* Exécuté dans le thread tcpip (API raw non thread-safe) */
+static void udp_raw_setup(void *ctx)
+{
+    struct udp_pcb *pcb = udp_new();
+    if (!pcb) {
+        ULOGE(TAG, "udp_new() failed");
+        return;
+    }
+    if (udp_bind(pcb, IP_ADDR_ANY, GP_UDP_PORT) != ERR_OK) {
+        ULOGE(TAG, "udp_bind(*:%d) failed", GP_UDP_PORT);
+        udp_remove(pcb);
+        return;
+    }
+    udp_recv(pcb, udp_raw_recv, NULL);
+    ULOGI(TAG, "listening on *:%d (lwIP raw, %s)", GP_UDP_PORT, WIFI_PROFILE_NAME);
+}
+
+#else
+
+/* Publie une trame reçue à stamp_us dans la queue (la plus ancienne saute si pleine) */
+static void forward_packet(const gp_packet_t *p, int64_t stamp_us)
+{
+    udp_rx_item_t item = { .pkt = *p, .stamp_us = stamp_us };
+    if (xQueueSend(s_rx_q, &item, 0) != pdPASS) {
+        udp_rx_item_t throwaway;
+        if (xQueueReceive(s_rx_q, &throwaway, 0) == pdTRUE) s_drop_cnt++;
+        if (xQueueSend(s_rx_q, &item, 0) != pdPASS) s_drop_cnt++;
+    }
+    gp_log_packet(p);
 }
 
+/*
+ * Lit un datagramme. Retourne 1 si trame de commande valide (copiée dans *p,
+ * instant de réception dans *stamp_us), 0 si datagramme ignoré, -1 si rien
+ * à lire (MSG_DONTWAIT) ou erreur.
+ */
+static int recv_one(int sock, int flags, gp_packet_t *p, int64_t *stamp_us,
+                    struct sockaddr_in *src, int *dump_left)
+{
+    uint8_t buf[128];
+    socklen_t sl = sizeof(*src);
+    int len = recvfrom(sock, buf, sizeof(buf), flags, (struct sockaddr*)src, &sl);
+    if (len < 0) return -1;
+    if (len == 0) return 0;
+    /* Même point de mesure que le callback raw : avant tout log ou drain */
+    int64_t now = esp_timer_get_time();
+
+    if ((*dump_left)-- > 0) {
+        ULOGI("udp_in", "pkt %dB from %s:%d", len, inet_ntoa(src->sin_addr), ntohs(src->sin_port));
+        log_buffer_bin("udp_in", buf, len);
+    }
+
+    if (len == (int)sizeof(gp_packet_t)) {
+#if CONFIG_GP_UDP_LOG_PACKETS
+        ULOGI("udp_in", "Raw UDP buffer:");
+        log_buffer_bin("udp_in", buf, len);
+#endif
+
+        s_rx_cnt++;
+        if (!rx_admit(src->sin_addr.s_addr, src->sin_port, now)) return 0;
+
+        memcpy(p, buf, sizeof(*p));
+        *stamp_us = now;
+        jitter_sample(now);
+        telemetry_note_peer(src->sin_addr.s_addr, src->sin_port);
+        return 1;
+    }
+
+    ULOGW(TAG, "Unexpected size %d (from %s:%d) - ignoring",
+          len, inet_ntoa(src->sin_addr), ntohs(src->sin_port));
+    return 0;
+}
+
+#if CONFIG_GP_UDP_DRAIN
+/* Garde la trame la plus récente par source ; table pleine → publiée tout de suite */
+static void keep_latest(udp_latest_t *latest, const struct sockaddr_in *src,
+                        const gp_packet_t *p, int64_t stamp_us)
+{
+    udp_latest_t *free_slot = NULL;
+
+    for (int i = 0; i < UDP_DRAIN_SOURCES; ++i) {
+        udp_latest_t *l = &latest[i];
+        if (!l->used) {
+            if (!free_slot) free_slot = l;
+            continue;
+        }
+        if (l->addr == src->sin_addr.s_addr && l->port == src->sin_port) {
+            l->pkt      = *p;
+            l->stamp_us = stamp_us;
+            s_coalesced_cnt++;
+            return;
+        }
+    }
+
+    if (!free_slot) { forward_packet(p, stamp_us); return; }
+    free_slot->used = true;
+    free_slot->addr = src->sin_addr.s_addr;
+    free_slot->port = src->sin_port;
+    free_slot->pkt  = *p;
+    free_slot->stamp_us = stamp_us;
+}
+#endif
+
 /* =============================== tâches ================================== */
 
 static void udp_task(void *arg)
-{  
+{
     int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
     if (sock < 0) {
         ULOGE(TAG, "socket() failed");
@@ -106,48 +379,100 @@ static void udp_task(void *arg)
         return;
     }
 
-    ULOGI(TAG, "listening on *:%d", GP_UDP_PORT);
+    ULOGI(TAG, "listening on *:%d (socket, %s)", GP_UDP_PORT, WIFI_PROFILE_NAME);
 
     int dump_left = 3;
     for (;;) {
-        uint8_t buf[128];
-        struct sockaddr_in src; socklen_t sl = sizeof(src);
-        int len = recvfrom(sock, buf, sizeof(buf), 0, (struct sockaddr*)&src, &sl);
-        if (len <= 0) continue;
-
-        if (dump_left-- > 0) {
-            ULOGI("udp_in", "pkt %dB from %s:%d", len, inet_ntoa(src.sin_addr), ntohs(src.sin_port));
-            log_buffer_bin("udp_in", buf, len);
+        gp_packet_t p;
+        int64_t stamp_us;
+        struct sockaddr_in src;
+
+#if CONFIG_GP_UDP_DRAIN
+        /* Réveil sur le premier datagramme, puis vidage sans bloquer de tout
+           ce que lwIP a déjà en tampon (rafale après agrégation Wi-Fi) */
+        udp_latest_t latest[UDP_DRAIN_SOURCES] = {0};
+        int r = recv_one(sock, 0, &p, &stamp_us, &src, &dump_left);
+        for (int n = 0; r >= 0 && n < UDP_DRAIN_MAX; ++n) {
+            if (r == 1) keep_latest(latest, &src, &p, stamp_us);
+            r = recv_one(sock, MSG_DONTWAIT, &p, &stamp_us, &src, &dump_left);
+        }
+        if (r == 1) keep_latest(latest, &src, &p, stamp_us);   // dernier lu au plafond
+
+        for (int i = 0; i < UDP_DRAIN_SOURCES; ++i) {
+            if (latest[i].used) forward_packet(&latest[i].pkt, latest[i].stamp_us);
         }
+#else
+        if (recv_one(sock, 0, &p, &stamp_us, &src, &dump_left) == 1) forward_packet(&p, stamp_us);
+#endif
+    }
+}
 
-        if (len == (int)sizeof(gp_packet_t)) {
-            gp_packet_t p;
+#endif /* CONFIG_GP_UDP_RX_RAW */
 
-            ULOGI("udp_in", "Raw UDP buffer:");
-            log_buffer_bin("udp_in", buf, len);
+/* Attend la prochaine trame à envoyer (la plus récente disponible), avec
+   son propre instant de réception */
+static void bridge_wait(udp_rx_item_t *it)
+{
+#if CONFIG_GP_UDP_RX_RAW
+    for (;;) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        portENTER_CRITICAL(&s_raw_mux);
+        bool ok = s_raw_pending;
+        it->pkt      = s_raw_latest;
+        it->stamp_us = s_raw_stamp_us;
+        s_raw_pending = false;
+        portEXIT_CRITICAL(&s_raw_mux);
+        if (ok) return;
+    }
+#else
+    while (xQueueReceive(s_rx_q, it, portMAX_DELAY) != pdTRUE) { }
+
+#if CONFIG_GP_UDP_DRAIN
+    /* Retard accumulé côté SPI : seule la trame la plus récente part */
+    udp_rx_item_t newer;
+    while (xQueueReceive(s_rx_q, &newer, 0) == pdTRUE) {
+        *it = newer;
+        s_coalesced_cnt++;
+    }
+#endif
+#endif
+}
 
-            memcpy(&p, buf, sizeof(p));
-            if (xQueueSend(s_rx_q, &p, 0) != pdPASS) {
-                gp_packet_t throwaway; (void)xQueueReceive(s_rx_q, &throwaway, 0);
-                if (xQueueSend(s_rx_q, &p, 0) != pdPASS) s_drop_cnt++;
-            }
-            gp_log_packet(&p);
-        } else {
-            // Optionnel : tu peux supprimer le parse_ascii_01_to_packet si tu ne veux plus supporter ce format
-            ULOGW(TAG, "Unexpected size %d (from %s:%d) - ignoring",
-                  len, inet_ntoa(src.sin_addr), ntohs(src.sin_port));
-        }
+/* Latence réception → départ SPI de la trame envoyée (reçue à stamp_us) */
+static void latency_account(int64_t stamp_us)
+{
+    uint32_t us = (uint32_t)(esp_timer_get_time() - stamp_us);
+    s_lat_sum_us += us;
+    if (us > s_lat_max_us) s_lat_max_us = us;
+
+    if (++s_lat_n == UDP_LAT_WINDOW) {
+        ULOGI(TAG, "rx->spi (%s) n=%u avg=%u us max=%u us coalesced=%" PRIu32,
+              UDP_RX_PATH_NAME, (unsigned)s_lat_n, (unsigned)(s_lat_sum_us / s_lat_n),
+              (unsigned)s_lat_max_us, s_coalesced_cnt);
+        s_lat_n = 0; s_lat_sum_us = 0; s_lat_max_us = 0;
+#if CONFIG_GP_SESSION_ARBITRATION
+        session_log();
+#endif
     }
+    jitter_report();
 }
 
 static void bridge_udp_to_spi_task(void *arg)
 {
     for (;;) {
-        gp_packet_t p;
-        if (xQueueReceive(s_rx_q, &p, portMAX_DELAY) != pdTRUE) continue;
-
-        esp_err_t err = spi_link_send(&p, sizeof(p), pdMS_TO_TICKS(5));
-        if (err == ESP_OK) continue;
+        udp_rx_item_t it;
+        bridge_wait(&it);
+        latency_account(it.stamp_us);
+
+        esp_err_t err = spi_link_send(&it.pkt, sizeof(it.pkt), pdMS_TO_TICKS(5));
+        if (err == ESP_OK) {
+            /* Statut STM32 reçu dans la même transaction (MISO) */
+            size_t len;
+            const uint8_t *miso = spi_link_last_rx(&len);
+            gp_car_status_t st;
+            if (miso && gp_car_status_find(miso, len, &st)) telemetry_set_car_status(&st);
+            continue;
+        }
 
         if (err == ESP_ERR_INVALID_STATE) {
             /* Bus occupé / maître absent → petit délai + poll */
@@ -166,8 +491,14 @@ esp_err_t udp_server_start(QueueHandle_t rx_queue)
     if (rx_queue == NULL) return ESP_ERR_INVALID_ARG;
     s_rx_q = rx_queue;
 
-    BaseType_t ok1 = xTaskCreate(udp_task, "udp_server", 4096, NULL, 5, NULL);
-    BaseType_t ok2 = xTaskCreate(bridge_udp_to_spi_task, "bridge_udp_spi", 4096, NULL, 6, NULL);
+#if CONFIG_GP_UDP_RX_RAW
+    /* Pas de tâche UDP : le callback lwIP notifie directement le pont */
+    BaseType_t ok2 = xTaskCreate(bridge_udp_to_spi_task, "bridge_udp_spi", 4096, NULL, BRIDGE_TASK_PRIO, &s_bridge_task);
+    BaseType_t ok1 = (ok2 == pdPASS && tcpip_callback(udp_raw_setup, NULL) == ERR_OK) ? pdPASS : pdFAIL;
+#else
+    BaseType_t ok1 = xTaskCreate(udp_task, "udp_server", 4096, NULL, UDP_TASK_PRIO, NULL);
+    BaseType_t ok2 = xTaskCreate(bridge_udp_to_spi_task, "bridge_udp_spi", 4096, NULL, BRIDGE_TASK_PRIO, NULL);
+#endif
 
     if (ok1 != pdPASS || ok2 != pdPASS) {
         ULOGE(TAG, "task creation failed");
@@ -180,7 +511,16 @@ QueueHandle_t udp_server_get_queue(void) { return s_rx_q; }
 
 UBaseType_t udp_buffer_count(void)
 {
+#if CONFIG_GP_UDP_RX_RAW
+    /* Pas de queue : 1 si une trame attend le pont dans la case raw */
+    return s_raw_pending ? 1 : 0;
+#else
     return (s_rx_q) ? uxQueueMessagesWaiting(s_rx_q) : 0;
+#endif
 }
 
 uint32_t udp_drop_count(void) { return s_drop_cnt; }
+
+uint32_t udp_rx_count(void) { return s_rx_cnt; }
+
+uint32_t udp_coalesced_count(void) { return s_coalesced_cnt; }
@@ -1,5 +1,6 @@
 #include "wifi_ap.h"
 
+#include "sdkconfig.h"
 #include <string.h>
 #include "esp_event.h"
 #include "esp_wifi.h"
@@ -27,6 +28,24 @@
   #define EXAMPLE_GTK_REKEY_INTERVAL  0
 #endif
 
+/*
+ * Profil radio "low-latency" (CONFIG_GP_WIFI_PROFILE_LOW_LATENCY) pour une
+ * trame de 28 o toutes les 10 ms :
+ *   - AMPDU RX/TX coupés : pas d'attente de réordonnancement Block-Ack,
+ *     chaque datagramme remonte seul dès sa réception ;
+ *   - pas de modem sleep (WIFI_PS_NONE) ;
+ *   - DTIM 1 et débits 11b désactivés : balises et broadcast plus courts
+ *     sur le canal ;
+ *   - HT20 : pas de bascule de largeur de canal.
+ * La priorité WMM (AC_VO) est portée par le DSCP posé par l'émetteur PC
+ * (APPLI, UDP_TOS) ; les priorités des tâches UDP/pont sont dans udp_server.c.
+ */
+#if CONFIG_GP_WIFI_PROFILE_LOW_LATENCY
+  #define WIFI_PROFILE_NAME  "low-latency"
+#else
+  #define WIFI_PROFILE_NAME  "default"
+#endif
+
 /* ============================ état du module ============================= */
 static const char *TAG = "wifi_ap";
 static volatile int s_sta_count = 0;
@@ -78,6 +97,10 @@ void wifi_ap_start(void)
 
     /* Wi-Fi driver */
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+#if CONFIG_GP_WIFI_PROFILE_LOW_LATENCY
+    cfg.ampdu_rx_enable = 0;
+    cfg.ampdu_tx_enable = 0;
+#endif
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
 
     /* Événements */
@@ -100,6 +123,10 @@ void wifi_ap_start(void)
 #endif
             .pmf_cfg        = { .required = true },
             .gtk_rekey_interval = EXAMPLE_GTK_REKEY_INTERVAL,
+#if CONFIG_GP_WIFI_PROFILE_LOW_LATENCY
+            .beacon_interval = CONFIG_GP_WIFI_BEACON_INTERVAL,
+            .dtim_period     = 1,
+#endif
         },
     };
     if (strlen(EXAMPLE_ESP_WIFI_PASS) == 0) {
@@ -109,15 +136,35 @@ void wifi_ap_start(void)
     /* Démarrage SoftAP */
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_AP));
     ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_AP, &wifi_config));
+#if CONFIG_GP_WIFI_PROFILE_LOW_LATENCY
+    ESP_ERROR_CHECK(esp_wifi_set_bandwidth(WIFI_IF_AP, WIFI_BW_HT20));
+    ESP_ERROR_CHECK(esp_wifi_config_11b_rate(WIFI_IF_AP, true));
+#endif
     ESP_ERROR_CHECK(esp_wifi_start());
+#if CONFIG_GP_WIFI_PROFILE_LOW_LATENCY
+    ESP_ERROR_CHECK(esp_wifi_set_ps(WIFI_PS_NONE));
+#endif
 
-    ULOGI(TAG, "SoftAP up. SSID:%s PASS:%s CH:%d",
+    ULOGI(TAG, "SoftAP up. SSID:%s PASS:%s CH:%d profile:%s",
           EXAMPLE_ESP_WIFI_SSID,
           (strlen(EXAMPLE_ESP_WIFI_PASS) ? EXAMPLE_ESP_WIFI_PASS : "<open>"),
-          EXAMPLE_ESP_WIFI_CHANNEL);
+          EXAMPLE_ESP_WIFI_CHANNEL, WIFI_PROFILE_NAME);
 }
 
 int wifi_ap_get_sta_count(void)
 {
     return s_sta_count;
 }
+
+bool wifi_ap_get_sta_rssi(int8_t *rssi)
+{
+    wifi_sta_list_t list;
+    if (esp_wifi_ap_get_sta_list(&list) != ESP_OK || list.num == 0) return false;
+
+    int8_t best = list.sta[0].rssi;
+    for (int i = 1; i < list.num; ++i) {
+        if (list.sta[i].rssi > best) best = list.sta[i].rssi;
+    }
+    *rssi = best;
+    return true;
+}
@@ -91,6 +91,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil              0
 #define INCLUDE_vTaskDelay                   1
 #define INCLUDE_xTaskGetSchedulerState       1
+#define INCLUDE_xTaskGetIdleTaskHandle       1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -135,6 +136,13 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Temps idle en cycles DWT pour la charge CPU du bloc de statut SPI (car_status.c) */
+#define configGENERATE_RUN_TIME_STATS            1
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void CarStatus_RunTimeInit(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() CarStatus_RunTimeInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()         (*(volatile uint32_t *)0xE0001004UL)  /* DWT->CYCCNT */
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
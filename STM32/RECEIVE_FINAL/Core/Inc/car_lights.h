@@ -0,0 +1,36 @@
+/**
+  ******************************************************************************
+  * @file    car_lights.h
+  * @brief   Feux du vehicule (stop, clignotants, recul) sur la barrette WS2812B.
+  ******************************************************************************
+  * StartDefaultTask derive l'etat des feux de chaque trame manette
+  * (CarLights_Derive) et ne reveille la tache LED (CarLights_Post) que si
+  * cet etat change : a 100 trames/s, l'encodage et le DMA LED ne passent
+  * jamais sur le chemin de commande.
+  */
+#ifndef CAR_LIGHTS_H
+#define CAR_LIGHTS_H
+
+#include <stdint.h>
+#include "cmsis_os.h"
+
+/* Bits d'etat des feux */
+#define LIGHT_BRAKE    (1u << 0)   /* lt enfonce */
+#define LIGHT_LEFT     (1u << 1)   /* lx < 0 */
+#define LIGHT_RIGHT    (1u << 2)   /* lx > 0 */
+#define LIGHT_REVERSE  (1u << 3)   /* rt - lt < 0 */
+
+/* lt / rt : valeurs du fil (-1 relachee .. +1), normalisees en interne */
+
+/* Etat des feux a partir de la manette, avec hysteresis autour des seuils */
+uint8_t CarLights_Derive(float lx, float lt, float rt, uint8_t prev);
+
+/* Handle de la tache LED (a appeler apres osThreadCreate) */
+void CarLights_Init(osThreadId task);
+
+/* Nouvel etat pour la tache LED (ecrase un etat pas encore rendu) */
+void CarLights_Post(uint8_t lights);
+
+void StartLightsTask(void const * argument);
+
+#endif /* CAR_LIGHTS_H */
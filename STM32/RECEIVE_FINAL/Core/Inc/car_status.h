@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file    car_status.h
+  * @brief   Bloc de statut STM32 renvoye a l'ESP32 sur MISO (SPI full-duplex).
+  ******************************************************************************
+  * A chaque front descendant de NSS, l'EXTI copie l'etat courant dans le
+  * buffer TX avant d'armer HAL_SPI_TransmitReceive_DMA : le maitre recupere
+  * le statut dans la transaction qui lui apporte la commande suivante, sans
+  * transaction supplementaire. Comme la reception, l'armement sur NSS decale
+  * les octets de quelques positions : l'ESP32 recherche CAR_STATUS_MAGIC.
+  *
+  * Meme format que gp_car_status_t cote ESP32 (little-endian, packed).
+  */
+#ifndef CAR_STATUS_H
+#define CAR_STATUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CAR_STATUS_MAGIC  0x41545343u   /* 'CSTA' sur le fil */
+
+typedef struct __attribute__((packed)) {
+  uint32_t magic;         /* CAR_STATUS_MAGIC */
+  uint16_t seq;           /* incremente a chaque bloc prepare */
+  uint16_t dir_duty;      /* dernier CCR applique, TIM2_CH3 */
+  uint16_t spd_duty;      /* dernier CCR applique, TIM3_CH1 */
+  uint8_t  lights;        /* bits LIGHT_* (car_lights.h) */
+  uint8_t  cpu_load;      /* % hors idle sur la derniere seconde */
+  uint32_t rx_frames;     /* trames SPI recues */
+  uint16_t rx_overruns;   /* trames perdues (spiRxQueue pleine) */
+  uint16_t spi_errors;    /* HAL_SPI_ErrorCallback */
+} CarStatus_t;
+
+_Static_assert(sizeof(CarStatus_t) == 20, "CarStatus_t must be 20 bytes");
+
+/* Mises a jour cote taches (ecritures 8/16 bits, atomiques) */
+void CarStatus_SetDir(uint16_t duty);
+void CarStatus_SetSpd(uint16_t duty);
+void CarStatus_SetLights(uint8_t lights);
+
+/* Cote ISR SPI */
+void CarStatus_FrameReceived(int queued);
+void CarStatus_SpiError(void);
+
+/* Copie coherente du bloc courant en tete de tx (len >= sizeof(CarStatus_t)),
+   depuis l'EXTI NSS (section critique FromISR) */
+void CarStatus_Fill(uint8_t *tx, size_t len);
+
+/* Charge CPU : a appeler regulierement depuis une tache (recalcul toutes les 1 s) */
+void CarStatus_UpdateLoad(void);
+
+/* Base de temps des stats FreeRTOS (DWT->CYCCNT), cf. FreeRTOSConfig.h */
+void CarStatus_RunTimeInit(void);
+
+#endif /* CAR_STATUS_H */
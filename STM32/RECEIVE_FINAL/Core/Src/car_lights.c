@@ -0,0 +1,213 @@
+/**
+  ******************************************************************************
+  * @file    car_lights.c
+  * @brief   Feux du vehicule : derivation depuis la manette + tache LED.
+  ******************************************************************************
+  * Barrette arriere 8 x WS2812B sur TIM1_CH3 / PA10 (AF1), DMA1_Ch7 req 7
+  * (meme brochage que VroomVroom ; SPI1 RX reste seul sur DMA1_Ch2).
+  *
+  *   LED  0-1 : clignotant gauche     6-7 : clignotant droit
+  *   LED  2-5 : veilleuse rouge, stop rouge plein, 3-4 blanc en recul
+  */
+
+#include "car_lights.h"
+#include "main.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <string.h>
+
+/* === Parametres ============================================================ */
+#define LIGHT_LEDS        8
+#define LIGHT_ARR         99      /* 80 MHz / 100 = 800 kHz, 1.25 us par bit */
+#define LIGHT_T1H         56      /* 0.7 us */
+#define LIGHT_T0H         32      /* 0.4 us */
+#define LIGHT_RESET       100     /* 125 us a 0 */
+#define LIGHT_BLINK_MS    350
+
+/* Seuils on / off (hysteresis : pas de re-rendu sur le bruit des axes).
+   Gachettes mesurees depuis la position relachee : 0 = relachee, 1 = a fond */
+#define BRAKE_ON          0.10f
+#define BRAKE_OFF         0.05f
+#define TURN_ON           0.30f
+#define TURN_OFF          0.20f
+#define REVERSE_ON       -0.10f
+#define REVERSE_OFF      -0.05f
+
+extern TIM_HandleTypeDef htim1;          /* main.c */
+extern DMA_HandleTypeDef hdma_tim1_ch3;
+
+static osThreadId s_task;
+static uint16_t   s_pwm[LIGHT_LEDS * 24 + LIGHT_RESET];
+static uint8_t    s_grb[LIGHT_LEDS][3];
+
+/* === Derivation ============================================================ */
+static uint8_t latch(uint8_t prev, uint8_t bit, int on, int keep)
+{
+  if (prev & bit) return keep ? bit : 0;
+  return on ? bit : 0;
+}
+
+/* Gachette sur le fil : -1 relachee .. +1 a fond -> 0 .. 1 */
+static float trigger01(float t)
+{
+  return (t + 1.0f) * 0.5f;
+}
+
+uint8_t CarLights_Derive(float lx, float lt, float rt, uint8_t prev)
+{
+  lt = trigger01(lt);
+  rt = trigger01(rt);
+  float net = rt - lt;
+  uint8_t s = 0;
+
+  s |= latch(prev, LIGHT_BRAKE,   lt  >  BRAKE_ON,   lt  >  BRAKE_OFF);
+  s |= latch(prev, LIGHT_LEFT,    lx  < -TURN_ON,    lx  < -TURN_OFF);
+  s |= latch(prev, LIGHT_RIGHT,   lx  >  TURN_ON,    lx  >  TURN_OFF);
+  s |= latch(prev, LIGHT_REVERSE, net <  REVERSE_ON, net <  REVERSE_OFF);
+  return s;
+}
+
+void CarLights_Init(osThreadId task)
+{
+  s_task = task;
+}
+
+void CarLights_Post(uint8_t lights)
+{
+  if (s_task) {
+    (void)xTaskNotify((TaskHandle_t)s_task, lights, eSetValueWithOverwrite);
+  }
+}
+
+/* === Materiel : TIM1_CH3 + DMA ============================================= */
+static void lights_hw_init(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+  TIM_OC_InitTypeDef s = {0};
+
+  __HAL_RCC_TIM1_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+
+  hdma_tim1_ch3.Instance                 = DMA1_Channel7;
+  hdma_tim1_ch3.Init.Request             = DMA_REQUEST_7;
+  hdma_tim1_ch3.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+  hdma_tim1_ch3.Init.PeriphInc           = DMA_PINC_DISABLE;
+  hdma_tim1_ch3.Init.MemInc              = DMA_MINC_ENABLE;
+  hdma_tim1_ch3.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  hdma_tim1_ch3.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+  hdma_tim1_ch3.Init.Mode                = DMA_NORMAL;
+  hdma_tim1_ch3.Init.Priority            = DMA_PRIORITY_LOW;   /* SPI1 RX d'abord */
+  if (HAL_DMA_Init(&hdma_tim1_ch3) != HAL_OK) Error_Handler();
+  __HAL_LINKDMA(&htim1, hdma[TIM_DMA_ID_CC3], hdma_tim1_ch3);
+
+  HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 6, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+
+  htim1.Instance               = TIM1;
+  htim1.Init.Prescaler         = 0;
+  htim1.Init.CounterMode       = TIM_COUNTERMODE_UP;
+  htim1.Init.Period            = LIGHT_ARR;
+  htim1.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+  htim1.Init.RepetitionCounter = 0;
+  htim1.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  if (HAL_TIM_PWM_Init(&htim1) != HAL_OK) Error_Handler();
+
+  s.OCMode     = TIM_OCMODE_PWM1;
+  s.Pulse      = 0;
+  s.OCPolarity = TIM_OCPOLARITY_HIGH;
+  s.OCFastMode = TIM_OCFAST_ENABLE;
+  s.OCIdleState = TIM_OCIDLESTATE_RESET;
+  if (HAL_TIM_PWM_ConfigChannel(&htim1, &s, TIM_CHANNEL_3) != HAL_OK) Error_Handler();
+
+  GPIO_InitStruct.Pin       = GPIO_PIN_10;
+  GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Pull      = GPIO_NOPULL;
+  GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_LOW;
+  GPIO_InitStruct.Alternate = GPIO_AF1_TIM1;
+  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+}
+
+/* === Rendu ================================================================= */
+static void set_rgb(int i, uint8_t r, uint8_t g, uint8_t b)
+{
+  s_grb[i][0] = g;
+  s_grb[i][1] = r;
+  s_grb[i][2] = b;
+}
+
+static void lights_render(uint8_t lights, int blink_on)
+{
+  memset(s_grb, 0, sizeof s_grb);
+
+  /* veilleuse / stop */
+  uint8_t red = (lights & LIGHT_BRAKE) ? 255 : 40;
+  for (int i = 2; i <= 5; i++) set_rgb(i, red, 0, 0);
+
+  if (lights & LIGHT_REVERSE) {
+    set_rgb(3, 200, 200, 200);
+    set_rgb(4, 200, 200, 200);
+  }
+  if (blink_on && (lights & LIGHT_LEFT)) {
+    set_rgb(0, 255, 100, 0);
+    set_rgb(1, 255, 100, 0);
+  }
+  if (blink_on && (lights & LIGHT_RIGHT)) {
+    set_rgb(6, 255, 100, 0);
+    set_rgb(7, 255, 100, 0);
+  }
+}
+
+static void lights_show(void)
+{
+  uint16_t *p = s_pwm;
+  const uint8_t *px = &s_grb[0][0];
+
+  for (int i = 0; i < LIGHT_LEDS * 3; i++) {
+    for (int b = 7; b >= 0; b--) {
+      *p++ = ((px[i] >> b) & 1u) ? LIGHT_T1H : LIGHT_T0H;
+    }
+  }
+  for (int i = 0; i < LIGHT_RESET; i++) *p++ = 0;
+
+  if (HAL_TIM_PWM_Start_DMA(&htim1, TIM_CHANNEL_3, (uint32_t*)s_pwm,
+                            (uint16_t)(p - s_pwm)) != HAL_OK) return;
+
+  /* ~365 us ; tache de plus basse priorite, la commande la preempte */
+  while (hdma_tim1_ch3.State != HAL_DMA_STATE_READY) { }
+
+  HAL_TIM_PWM_Stop_DMA(&htim1, TIM_CHANNEL_3);
+}
+
+/* === Tache ================================================================= */
+void StartLightsTask(void const * argument)
+{
+  (void)argument;
+  uint32_t lights = 0;
+  int blink_on = 1;
+
+  lights_hw_init();
+  lights_render(0, 0);
+  lights_show();
+
+  for (;;) {
+    /* Bloquee tant que rien ne change ; reveil periodique seulement si un
+       clignotant est actif */
+    TickType_t wait = (lights & (LIGHT_LEFT | LIGHT_RIGHT))
+                    ? pdMS_TO_TICKS(LIGHT_BLINK_MS) : portMAX_DELAY;
+    uint32_t v;
+
+    if (xTaskNotifyWait(0, 0, &v, wait) == pdTRUE) {
+      if (v == lights) continue;
+      lights = v;
+      blink_on = 1;
+    } else {
+      blink_on = !blink_on;
+    }
+
+    lights_render((uint8_t)lights, blink_on);
+    lights_show();
+  }
+}
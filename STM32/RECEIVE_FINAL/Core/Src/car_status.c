@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file    car_status.c
+  * @brief   Bloc de statut STM32 pour le MISO du lien SPI (cf. car_status.h).
+  ******************************************************************************
+  */
+
+#include "car_status.h"
+#include "main.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <string.h>
+
+#define LOAD_WINDOW_MS  1000
+
+static volatile CarStatus_t s_status = { .magic = CAR_STATUS_MAGIC };
+
+/* === Mises a jour ========================================================== */
+void CarStatus_SetDir(uint16_t duty)      { s_status.dir_duty = duty; }
+void CarStatus_SetSpd(uint16_t duty)      { s_status.spd_duty = duty; }
+void CarStatus_SetLights(uint8_t lights)  { s_status.lights = lights; }
+
+void CarStatus_FrameReceived(int queued)
+{
+  s_status.rx_frames++;
+  if (!queued) s_status.rx_overruns++;
+}
+
+void CarStatus_SpiError(void)
+{
+  s_status.spi_errors++;
+}
+
+void CarStatus_Fill(uint8_t *tx, size_t len)
+{
+  CarStatus_t snap;
+
+  if (len < sizeof(CarStatus_t)) return;
+
+  /* Copie figee sous section critique : aucune ISR SPI / DMA (priorite 5)
+     ni tache ne modifie un champ pendant la copie. seq est ecrit en
+     dernier, une fois le reste du bloc copie. */
+  UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+  memcpy(&snap, (const void *)&s_status, sizeof(snap));
+  snap.seq = ++s_status.seq;
+  taskEXIT_CRITICAL_FROM_ISR(saved);
+
+  memcpy(tx, &snap, sizeof(snap));
+}
+
+/* === Charge CPU ============================================================ */
+/* Temps idle mesure par FreeRTOS (configGENERATE_RUN_TIME_STATS) en cycles
+   CPU : la tache idle tourne en boucle (pas de WFI), CYCCNT avance. */
+void CarStatus_RunTimeInit(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void CarStatus_UpdateLoad(void)
+{
+  static TickType_t last_tick;
+  static uint32_t   last_total, last_idle;
+
+  TickType_t now = xTaskGetTickCount();
+  if ((now - last_tick) < pdMS_TO_TICKS(LOAD_WINDOW_MS)) return;
+  last_tick = now;
+
+  uint32_t total = DWT->CYCCNT;
+  uint32_t idle  = ulTaskGetIdleRunTimeCounter();
+  uint32_t dt    = total - last_total;
+  uint32_t di    = idle - last_idle;
+  last_total = total;
+  last_idle  = idle;
+
+  if (dt == 0 || di > dt) return;
+  s_status.cpu_load = (uint8_t)(100u - (uint32_t)(((uint64_t)di * 100u) / dt));
+}
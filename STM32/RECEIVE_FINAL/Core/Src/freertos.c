@@ -7,6 +7,8 @@
 
 #include "cmsis_os.h"
 #include "main.h"
+#include "car_lights.h"
+#include "car_status.h"
 
 /* FreeRTOS */
 #include "FreeRTOS.h"
@@ -152,10 +154,15 @@ void MX_FREERTOS_Init(void)
   osThreadDef(spdTask, StartSpdTask, osPriorityAboveNormal, 0, 256);
   osThreadId spdH = osThreadCreate(osThread(spdTask), NULL);
 
+  /* Feux : plus basse priorite, reveillee seulement sur changement d'etat */
+  osThreadDef(lightsTask, StartLightsTask, osPriorityLow, 0, 256);
+  osThreadId lightsH = osThreadCreate(osThread(lightsTask), NULL);
+  CarLights_Init(lightsH);
+
   {
     char buf[96];
-    int n = snprintf(buf, sizeof buf, "[BOOT] default=%p dir=%p spd=%p\r\n",
-                     defH, dirH, spdH);
+    int n = snprintf(buf, sizeof buf, "[BOOT] default=%p dir=%p spd=%p lights=%p\r\n",
+                     defH, dirH, spdH, lightsH);
     HAL_UART_Transmit(&huart2, (uint8_t*)buf, (uint16_t)n, 50);
   }
 
@@ -167,6 +174,7 @@ static void StartDefaultTask(void const * argument)
 {
   SpiFrame_t frame;
   GamepadFrame_t g;
+  uint8_t lights = 0;
 
   for(;;) {
     if (xQueueReceive(spiRxQueue, &frame, portMAX_DELAY) == pdTRUE) {
@@ -181,6 +189,15 @@ static void StartDefaultTask(void const * argument)
       (void)xQueueOverwrite(qDirection, &dmsg);
       (void)xQueueOverwrite(qVitesse,   &vmsg);
 
+      /* Feux : la tache LED n'est reveillee que si l'etat derive change */
+      uint8_t l = CarLights_Derive(g.lx, g.lt, g.rt, lights);
+      if (l != lights) {
+        lights = l;
+        CarLights_Post(lights);
+        CarStatus_SetLights(lights);
+      }
+      CarStatus_UpdateLoad();
+
       char lx[12], lt[12], rt[12], line[64];
       fmt_f2(lx, sizeof lx, LX_value);
       fmt_f2(lt, sizeof lt, LT_value);
@@ -201,6 +218,7 @@ void StartDirTask(void const * argument)
     vTaskSuspend(NULL);
   }
   __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_3, DIR_CENTER);
+  CarStatus_SetDir(DIR_CENTER);
   HAL_UART_Transmit(&huart2, (uint8_t*)"[DIR] up, CCR=1400\r\n", 19, 10);
 
   DirectionMsg msg;
@@ -218,6 +236,7 @@ void StartDirTask(void const * argument)
       }
       if (duty != lastDuty) {
         __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_3, (uint16_t)duty);
+        CarStatus_SetDir((uint16_t)duty);
         char l[32]; int n = snprintf(l, sizeof l, "[DIR] CCR=%d\r\n", duty);
         HAL_UART_Transmit(&huart2, (uint8_t*)l, (uint16_t)n, 10);
         lastDuty = duty;
@@ -236,6 +255,7 @@ void StartSpdTask(void const * argument)
     vTaskSuspend(NULL);
   }
   __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, SPD_CENTER);
+  CarStatus_SetSpd(SPD_CENTER);
   HAL_UART_Transmit(&huart2, (uint8_t*)"[SPD] up, CCR=1400\r\n", 19, 10);
 
   VitesseMsg msg;
@@ -253,6 +273,7 @@ void StartSpdTask(void const * argument)
       }
       if (duty != lastDuty) {
         __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, (uint16_t)duty);
+        CarStatus_SetSpd((uint16_t)duty);
         char l[32]; int n = snprintf(l, sizeof l, "[SPD] CCR=%d\r\n", duty);
         HAL_UART_Transmit(&huart2, (uint8_t*)l, (uint16_t)n, 10);
         lastDuty = duty;
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include "FreeRTOS.h"
 #include "queue.h"
+#include "car_status.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -38,13 +39,16 @@ typedef struct { uint8_t bytes[64]; } SpiFrame_t;
 /* Private variables ---------------------------------------------------------*/
 SPI_HandleTypeDef hspi1;
 DMA_HandleTypeDef hdma_spi1_rx;
-DMA_HandleTypeDef hdma_spi1_tx;   /* présent si CubeMX le référence dans MSP */
+DMA_HandleTypeDef hdma_spi1_tx;   /* MISO : bloc de statut (car_status.h) */
 TIM_HandleTypeDef htim2;          /* TIM2_CH3 -> PB10 (AF1) : direction */
 TIM_HandleTypeDef htim3;          /* TIM3_CH1 -> PB4  (AF2) : vitesse */
+TIM_HandleTypeDef htim1;          /* TIM1_CH3 -> PA10 (AF1) : feux (car_lights.c) */
+DMA_HandleTypeDef hdma_tim1_ch3;
 UART_HandleTypeDef huart2;
 
 /* USER CODE BEGIN PV */
 static uint8_t spi_rx_buf[FRAME_LEN];
+static uint8_t spi_tx_buf[FRAME_LEN];
 extern QueueHandle_t spiRxQueue;  /* vient de freertos.c */
 /* USER CODE END PV */
 
@@ -145,12 +149,14 @@ static void MX_USART2_UART_Init(void)
   if (HAL_UART_Init(&huart2) != HAL_OK) Error_Handler();
 }
 
-/* === DMA (SPI1 RX sur DMA1_Ch2) =========================================== */
+/* === DMA (SPI1 RX sur DMA1_Ch2, TX sur DMA1_Ch3) ========================== */
 static void MX_DMA_Init(void)
 {
   __HAL_RCC_DMA1_CLK_ENABLE();
   HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, 5, 0);
   HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+  HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
 }
 
 /* === GPIO (PB0 EXTI pour NSS monitor) ===================================== */
@@ -230,20 +236,25 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
   if (GPIO_Pin == NSS_MON_PIN) {
     if (HAL_SPI_GetState(&hspi1) == HAL_SPI_STATE_READY) {
-      (void)HAL_SPI_Receive_DMA(&hspi1, spi_rx_buf, FRAME_LEN);
+      /* Full-duplex : le maitre recoit le statut en meme temps qu'il envoie
+         la commande */
+      CarStatus_Fill(spi_tx_buf, FRAME_LEN);
+      (void)HAL_SPI_TransmitReceive_DMA(&hspi1, spi_tx_buf, spi_rx_buf, FRAME_LEN);
     }
   }
 }
 
-void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
 {
   if (hspi->Instance == SPI1) {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     SpiFrame_t frame;
+    int queued = 0;
     memcpy(frame.bytes, spi_rx_buf, FRAME_LEN);
     if (spiRxQueue) {
-      xQueueSendFromISR(spiRxQueue, &frame, &xHigherPriorityTaskWoken);
+      queued = (xQueueSendFromISR(spiRxQueue, &frame, &xHigherPriorityTaskWoken) == pdTRUE);
     }
+    CarStatus_FrameReceived(queued);
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
   }
 }
@@ -251,6 +262,7 @@ void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
 void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
 {
   if (hspi->Instance == SPI1) {
+    CarStatus_SpiError();
     (void)HAL_SPI_Abort(hspi);
   }
 }
@@ -31,19 +31,20 @@ extern "C" {
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-#define LED_COUNT 8
-#define BITS_PER_LED 24
-#define RESET_SLOTS 100
-#define LED_BUFFER_SIZE (LED_COUNT * BITS_PER_LED + RESET_SLOTS)
-
-#define CIRCLE_LED_COUNT 7
-#define CIRCLE_BITS_PER_LED 32
-#define CIRCLE_LED_BUFFER_SIZE (CIRCLE_LED_COUNT * CIRCLE_BITS_PER_LED + RESET_SLOTS)
-
-#define ARR_VALUE 99
-
-#define T1H_TICKS   64
-#define T0H_TICKS   32
+#include "np_encode.h"
+
+/* Backend NeoPixel : TIM1 PWM + DMA (1 CCR 16 bits par bit LED)
+ * ou MOSI SPI + DMA (12 bits SPI par bit LED, TIM1 libre, voir np_spi.h) */
+#define NP_BACKEND_TIM 0
+#define NP_BACKEND_SPI 1
+#define NP_BACKEND NP_BACKEND_TIM
+
+/* Chaines NeoPixel, une ligne par chaine (voir np_chain.h) :
+ *   nom, ordre des canaux (GRB / GRBW), nombre de LEDs,
+ *   canal TIM1 + handle DMA (backend TIM), chaine np_spi (backend SPI) */
+#define NP_CHAINS(X) \
+  X(stick,  GRB,  8, TIM_CHANNEL_3, hdma_tim1_ch3, NP_SPI_STICK) \
+  X(circle, GRBW, 7, TIM_CHANNEL_2, hdma_tim1_ch2, NP_SPI_CIRCLE)
 
 /* USER CODE END Includes */
 
@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file    np_chain.h
+  * @brief   Driver NeoPixel generique, specialise a la compilation par chaine.
+  ******************************************************************************
+  * Les chaines sont listees une fois dans NP_CHAINS (main.h). Pour chacune,
+  * NP_CHAIN_DEFINE genere buffers et fonctions avec l'ordre des canaux, le
+  * nombre d'octets par LED et la taille en constantes :
+  *
+  *   np_<nom>_set_pixel(i, r, g, b, w)   w ignore pour une chaine GRB
+  *   np_<nom>_fill(r, g, b, w)
+  *   np_<nom>_clear()
+  *   np_<nom>_show()
+  *   np_perf_<nom>                       cycles DWT de la derniere trame
+  *   NP_LEDS_<nom>                       nombre de LEDs
+  *
+  * Ajouter une chaine = une ligne dans NP_CHAINS (plus la config DMA CubeMX
+  * du canal TIM1, ou une entree np_spi pour le backend SPI).
+  */
+#ifndef NP_CHAIN_H
+#define NP_CHAIN_H
+
+#include <string.h>
+#include "main.h"
+#include "np_encode.h"
+#if NP_BACKEND == NP_BACKEND_SPI
+#include "np_spi.h"
+#endif
+
+/* Ordres de canaux : octets par LED et rangement sur le fil */
+#define NP_BPP_GRB    3
+#define NP_BPP_GRBW   4
+#define NP_PACK_GRB(px, r, g, b, w)   ((void)(w), np_pack_grb(px, r, g, b))
+#define NP_PACK_GRBW(px, r, g, b, w)  np_pack_grbw(px, r, g, b, w)
+
+#if NP_BACKEND == NP_BACKEND_SPI
+typedef uint8_t np_slot_t;                    // octets SPI
+#define NP_SLOTS(bits)    ((bits) * NP_SPI_BITS_PER_BIT / 8)
+#define NP_RESET_SLOTS    NP_SPI_RESET_SLOTS
+#define NP_ENCODE         np_encode_spi_inline
+#define NP_TRANSMIT(buf, len, tim_ch, hdma, spi_id) np_spi_transmit(spi_id, buf, len)
+#else
+typedef uint16_t np_slot_t;                   // valeurs CCR
+#define NP_SLOTS(bits)    (bits)
+#define NP_RESET_SLOTS    NP_PWM_RESET_SLOTS
+#define NP_ENCODE         np_encode_pwm_inline
+#define NP_TRANSMIT(buf, len, tim_ch, hdma, spi_id) np_transmit_tim(tim_ch, &hdma, buf, len)
+
+extern TIM_HandleTypeDef htim1;
+
+static inline void np_transmit_tim(uint32_t channel, DMA_HandleTypeDef *hdma,
+                                   np_slot_t *buf, uint16_t len)
+{
+  __HAL_TIM_SET_AUTORELOAD(&htim1, ARR_VALUE);
+
+  HAL_TIM_PWM_Start_DMA(&htim1, channel, (uint32_t*)buf, len);
+
+  // Attendre la fin du DMA
+  while (hdma->State != HAL_DMA_STATE_READY) { }
+
+  HAL_TIM_PWM_Stop_DMA(&htim1, channel);
+}
+#endif
+
+#define NP_CHAIN_BYTES(order, count)  ((count) * NP_BPP_##order)
+#define NP_CHAIN_SLOTS(order, count)  (NP_SLOTS(NP_CHAIN_BYTES(order, count) * 8) + NP_RESET_SLOTS)
+
+/* Cycles CPU (DWT) de la derniere trame : encodage puis transfert */
+typedef struct {
+  uint32_t encode_cycles;
+  uint32_t xfer_cycles;
+} np_perf_t;
+
+/* Somme des niveaux de toutes les chaines (budget courant partage) */
+uint32_t np_level_total(void);
+
+/* Somme des niveaux apres gamma d'une LED, bpp constant donc deroule */
+static inline uint32_t np_chain_level(const uint8_t *px, int bpp)
+{
+  uint32_t sum = 0;
+  for (int c = 0; c < bpp; c++) sum += np_color_level(px[c]);
+  return sum;
+}
+
+#define NP_CHAIN_LEDS(name, order, count, tim_ch, hdma, spi_id)  NP_LEDS_##name = (count),
+
+#define NP_CHAIN_DECLARE(name, order, count, tim_ch, hdma, spi_id)                     \
+  void np_##name##_set_pixel(uint16_t i, uint8_t r, uint8_t g, uint8_t b, uint8_t w);  \
+  void np_##name##_fill(uint8_t r, uint8_t g, uint8_t b, uint8_t w);                   \
+  void np_##name##_clear(void);                                                        \
+  void np_##name##_show(void);                                                         \
+  extern volatile np_perf_t np_perf_##name;
+
+#define NP_CHAIN_LEVEL_SUM(name, order, count, tim_ch, hdma, spi_id)  + np_##name##_level_sum
+
+/* A instancier une seule fois : NP_CHAINS(NP_CHAIN_DEFINE) */
+#define NP_CHAIN_DEFINE(name, order, count, tim_ch, hdma, spi_id)                      \
+  extern DMA_HandleTypeDef hdma;                                                       \
+  static np_slot_t np_##name##_buf[NP_CHAIN_SLOTS(order, count)];                      \
+  static uint8_t   np_##name##_px[count][NP_BPP_##order];                              \
+  static uint8_t   np_##name##_residue[count][NP_BPP_##order];   /* dithering */       \
+  static uint32_t  np_##name##_level_sum;                                              \
+  volatile np_perf_t np_perf_##name;                                                   \
+                                                                                       \
+  void np_##name##_set_pixel(uint16_t i, uint8_t r, uint8_t g, uint8_t b, uint8_t w)   \
+  {                                                                                    \
+    if (i >= (count)) return;                                                          \
+    np_##name##_level_sum -= np_chain_level(np_##name##_px[i], NP_BPP_##order);        \
+    NP_PACK_##order(np_##name##_px[i], r, g, b, w);                                    \
+    np_##name##_level_sum += np_chain_level(np_##name##_px[i], NP_BPP_##order);        \
+  }                                                                                    \
+                                                                                       \
+  void np_##name##_fill(uint8_t r, uint8_t g, uint8_t b, uint8_t w)                    \
+  {                                                                                    \
+    for (uint16_t i = 0; i < (count); i++) np_##name##_set_pixel(i, r, g, b, w);       \
+  }                                                                                    \
+                                                                                       \
+  void np_##name##_clear(void)                                                         \
+  {                                                                                    \
+    memset(np_##name##_px, 0, sizeof(np_##name##_px));                                 \
+    np_##name##_level_sum = 0;                                                         \
+  }                                                                                    \
+                                                                                       \
+  void np_##name##_show(void)                                                          \
+  {                                                                                    \
+    uint32_t t0 = DWT->CYCCNT;                                                         \
+    uint16_t scale = np_color_frame_scale(np_level_total());                           \
+    np_slot_t *p = NP_ENCODE(np_##name##_buf, &np_##name##_px[0][0],                   \
+                             &np_##name##_residue[0][0],                               \
+                             NP_CHAIN_BYTES(order, count), scale);                     \
+                                                                                       \
+    uint32_t t1 = DWT->CYCCNT;                                                         \
+    NP_TRANSMIT(np_##name##_buf, (uint16_t)(p - np_##name##_buf), tim_ch, hdma, spi_id); \
+                                                                                       \
+    np_perf_##name.encode_cycles = t1 - t0;                                            \
+    np_perf_##name.xfer_cycles = DWT->CYCCNT - t1;                                     \
+  }
+
+enum { NP_CHAINS(NP_CHAIN_LEDS) };
+NP_CHAINS(NP_CHAIN_DECLARE)
+
+#endif /* NP_CHAIN_H */
@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file    np_color.h
+  * @brief   Etage couleur NeoPixel : gamma, luminosite globale, budget de
+  *          courant et dithering temporel.
+  ******************************************************************************
+  * np_color_apply() est appelee octet par octet pendant l'encodage (np_<chaine>_show),
+  * il n'y a donc pas de passe supplementaire sur le framebuffer.
+  *
+  * Budget courant : chaque chaine tient a jour la somme de ses canaux apres
+  * gamma (np_color_level) dans np_<chaine>_set_pixel. np_color_frame_scale() en deduit
+  * le facteur d'echelle de la trame sans relire les pixels.
+  */
+#ifndef NP_COLOR_H
+#define NP_COLOR_H
+
+#include <stdint.h>
+
+/* Courant d'un canal allume a 255 (WS2812B / SK6812 : ~20 mA) */
+#ifndef NP_MA_PER_CHANNEL
+#define NP_MA_PER_CHANNEL     20
+#endif
+
+/* Budget total des deux chaines (limite du regulateur 5 V) */
+#ifndef NP_CURRENT_BUDGET_MA
+#define NP_CURRENT_BUDGET_MA  500
+#endif
+
+/* 1 = dithering temporel (utile seulement si les LEDs sont rafraichies en continu) */
+#ifndef NP_DITHER
+#define NP_DITHER             1
+#endif
+
+/* Table gamma 2.6 precalculee, sortie en virgule fixe 8.8 */
+extern const uint16_t np_gamma16[256];
+
+void     np_color_set_brightness(uint8_t brightness);
+uint8_t  np_color_get_brightness(void);
+void     np_color_set_budget_ma(uint16_t budget_ma);
+
+/* Facteur d'echelle de la trame (0..256) a partir de la somme des niveaux */
+uint16_t np_color_frame_scale(uint32_t level_sum);
+
+/* Niveau lineaire (0..255) d'un octet apres gamma : proxy du courant consomme */
+static inline uint32_t np_color_level(uint8_t raw)
+{
+  return np_gamma16[raw] >> 8;
+}
+
+/*
+ * Gamma + echelle + dithering d'un octet.
+ * residue : partie fractionnaire reportee d'une trame a l'autre pour ce canal.
+ * 65280 + 255 = 65535 au pire, donc pas de saturation a faire apres le >> 8.
+ */
+static inline uint8_t np_color_apply(uint8_t raw, uint16_t scale, uint8_t *residue)
+{
+  uint32_t v = ((uint32_t)np_gamma16[raw] * scale) >> 8;
+#if NP_DITHER
+  v += *residue;
+  *residue = (uint8_t)v;
+#else
+  (void)residue;
+#endif
+  return (uint8_t)(v >> 8);
+}
+
+#endif /* NP_COLOR_H */
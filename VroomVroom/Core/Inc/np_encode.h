@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file    np_encode.h
+  * @brief   Encodage NeoPixel independant du HAL (TIM1 PWM ou SPI MOSI).
+  ******************************************************************************
+  * Les fonctions prennent un framebuffer deja dans l'ordre du fil (GRB / GRBW),
+  * appliquent l'etage couleur (np_color_apply) et ecrivent les slots suivis
+  * du reset. Ce module se compile aussi sur PC (VroomVroom/Host).
+  */
+#ifndef NP_ENCODE_H
+#define NP_ENCODE_H
+
+#include <stdint.h>
+#include "np_color.h"
+
+/* TIM1 a 80 MHz, ARR = 99 : 100 ticks = 1.25 us par bit LED */
+#define ARR_VALUE   99
+#define T1H_TICKS   56    // 0.7 us : dans les specs WS2812B (0.65..0.95) et SK6812 (0.45..0.75)
+#define T0H_TICKS   32    // 0.4 us
+
+#define NP_PWM_RESET_SLOTS  100   // 125 us a 0
+#define NP_SPI_RESET_SLOTS  128   // 128 octets a 0 = 102 us a 10 MHz
+
+/* SPI a 10 MHz : 12 bits SPI (1.2 us) par bit LED, donc 12 octets SPI par octet couleur */
+#define NP_SPI_BITS_PER_BIT 12
+
+/* Motifs 24 bits d'une paire de bits LED pour le backend SPI (2 x 12 bits) */
+extern const uint32_t np_spi_pair[4];
+
+static inline void np_pack_grb(uint8_t *px, uint8_t r, uint8_t g, uint8_t b)
+{
+  px[0] = g;
+  px[1] = r;
+  px[2] = b;
+}
+
+static inline void np_pack_grbw(uint8_t *px, uint8_t r, uint8_t g, uint8_t b, uint8_t w)
+{
+  px[0] = g;
+  px[1] = r;
+  px[2] = b;
+  px[3] = w;
+}
+
+/* Encode un octet couleur en NP_SPI_BITS_PER_BIT octets SPI, MSB en premier */
+static inline void np_spi_encode_byte(uint8_t byte, uint8_t *out)
+{
+#pragma GCC unroll 4
+  for (int shift = 6; shift >= 0; shift -= 2) {
+    uint32_t bits = np_spi_pair[(byte >> shift) & 3u];
+    *out++ = (uint8_t)(bits >> 16);
+    *out++ = (uint8_t)(bits >> 8);
+    *out++ = (uint8_t)bits;
+  }
+}
+
+/*
+ * Versions inline pour les chaines de np_chain.h : nbytes y est une constante,
+ * le compilateur deroule alors entierement les boucles (jusqu'a 32 octets)
+ * et le choix T0H/T1H se fait sans branchement.
+ */
+#define NP_ALWAYS_INLINE static inline __attribute__((always_inline))
+
+NP_ALWAYS_INLINE uint16_t *np_encode_pwm_inline(uint16_t *out, const uint8_t *px, uint8_t *residue,
+                                                uint16_t nbytes, uint16_t scale)
+{
+#pragma GCC unroll 32
+  for (uint16_t i = 0; i < nbytes; i++) {
+    uint32_t v = np_color_apply(px[i], scale, &residue[i]);
+#pragma GCC unroll 8
+    for (int b = 7; b >= 0; b--) {
+      *out++ = (uint16_t)(T0H_TICKS + ((v >> b) & 1u) * (T1H_TICKS - T0H_TICKS));
+    }
+  }
+  for (int i = 0; i < NP_PWM_RESET_SLOTS; i++) *out++ = 0;
+  return out;
+}
+
+NP_ALWAYS_INLINE uint8_t *np_encode_spi_inline(uint8_t *out, const uint8_t *px, uint8_t *residue,
+                                               uint16_t nbytes, uint16_t scale)
+{
+#pragma GCC unroll 32
+  for (uint16_t i = 0; i < nbytes; i++) {
+    np_spi_encode_byte(np_color_apply(px[i], scale, &residue[i]), out);
+    out += NP_SPI_BITS_PER_BIT;
+  }
+  for (int i = 0; i < NP_SPI_RESET_SLOTS; i++) *out++ = 0;
+  return out;
+}
+
+/*
+ * Encode nbytes octets de px (un residu de dithering par octet) puis le reset.
+ * Retourne la fin du buffer ecrit : la longueur DMA est (retour - out).
+ */
+uint16_t *np_encode_pwm(uint16_t *out, const uint8_t *px, uint8_t *residue,
+                        uint16_t nbytes, uint16_t scale);
+uint8_t  *np_encode_spi(uint8_t *out, const uint8_t *px, uint8_t *residue,
+                        uint16_t nbytes, uint16_t scale);
+
+#endif /* NP_ENCODE_H */
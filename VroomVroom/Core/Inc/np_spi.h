@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file    np_spi.h
+  * @brief   Backend NeoPixel sur la ligne MOSI d'un SPI (NP_BACKEND_SPI).
+  ******************************************************************************
+  * Chaque bit LED devient 12 bits SPI a 10 MHz (80 MHz / 8, 100 ns par bit) :
+  *   0 -> 1111 0000 0000 : T0H = 0.4 us, T0L = 0.8 us
+  *   1 -> 1111 1110 0000 : T1H = 0.7 us, T1L = 0.5 us
+  * dans les specs WS2812B (barrette) et SK6812 (anneau), verifiees par
+  * Host/np_verify. A 5 MHz, T1H ne peut valoir que 0.6 ou 0.8 us, hors de
+  * la fenetre commune 0.65..0.75 us. Un octet couleur occupe 12 octets SPI,
+  * contre 8 mots 16 bits (CCR) ; l'encodage est dans np_encode.c.
+  *
+  * Brochage (TIM1 reste libre pour la commande moteur) :
+  *   barrette : SPI2_MOSI PB15 (AF5), DMA1_Channel5 request 1
+  *   anneau   : SPI1_MOSI PA7  (AF5), DMA2_Channel4 request 4
+  *
+  * Comparaison (8 LEDs GRB + 7 LEDs GRBW, valeurs theoriques) :
+  *                      TIM1 PWM + DMA        SPI MOSI + DMA
+  *   RAM buffers        584 + 648 = 1232 o    416 + 464 = 880 o
+  *   requetes DMA       292 + 324             416 + 464
+  *   trame barrette     365 us                332 us
+  *   trame anneau       405 us                371 us
+  * Les cycles reels d'encodage et de transfert sont mesures par np_<chaine>_show
+  * (np_perf_stick / np_perf_circle, compteur DWT).
+  */
+#ifndef NP_SPI_H
+#define NP_SPI_H
+
+#include <stdint.h>
+
+typedef enum {
+  NP_SPI_STICK = 0,
+  NP_SPI_CIRCLE,
+  NP_SPI_COUNT
+} np_spi_chain_t;
+
+void np_spi_init(void);
+
+/* Lance le DMA et attend la fin de la trame */
+void np_spi_transmit(np_spi_chain_t chain, const uint8_t *buf, uint16_t len);
+
+#endif /* NP_SPI_H */
@@ -25,7 +25,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "ensi_uart.h"
-#include <string.h>
+#include "np_chain.h"
 
 /* USER CODE END Includes */
 
@@ -47,136 +47,27 @@
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
 
-extern TIM_HandleTypeDef htim1;
-extern DMA_HandleTypeDef hdma_tim1_ch3;
-extern DMA_HandleTypeDef hdma_tim1_ch2;
-
-static uint16_t led_buffer[LED_BUFFER_SIZE];
-static uint8_t RGB_buffer[LED_COUNT][3];
-
-static uint16_t circle_led_buffer[CIRCLE_LED_BUFFER_SIZE];
-static uint8_t circle_RGBW_buffer[CIRCLE_LED_COUNT][4];
+/* Buffers, framebuffers et fonctions np_<chaine>_* (voir np_chain.h) */
+NP_CHAINS(NP_CHAIN_DEFINE)
 
 /* USER CODE END Variables */
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN FunctionPrototypes */
 
-static void byte_to_pwm(uint8_t byte, uint16_t *out);
-
-void np_set_pixel(uint16_t i, uint8_t r, uint8_t g, uint8_t b);
-void np_set_all_leds(uint8_t r, uint8_t g, uint8_t b);
-void np_clear(void);
-void np_show(void);
+static void np_perf_init(void);
 
-void np_set_pixel_circle(uint16_t i, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
-void np_set_all_leds_circle(uint8_t r, uint8_t g, uint8_t b, uint8_t w);
-void np_clear_circle(void);
-void np_show_circle(void);
-
-/*
- *
- * STICK LED
- *
- */
-
-static void byte_to_pwm(uint8_t byte, uint16_t *out) {
-  for (int i = 0; i < 8; i++) {
-    out[i] = (byte & (1 << (7 - i))) ? T1H_TICKS : T0H_TICKS;
-  }
-}
-
-
-void np_set_pixel(uint16_t i, uint8_t r, uint8_t g, uint8_t b) {
-  if (i >= LED_COUNT) return;
-  RGB_buffer[i][0] = g;
-  RGB_buffer[i][1] = r;
-  RGB_buffer[i][2] = b;
-}
-
-void np_set_all_leds(uint8_t r, uint8_t g, uint8_t b){
-	for (int pos = 0; pos < LED_COUNT; pos++) {
-		np_set_pixel(pos, r, g, b);
-	}
+static void np_perf_init(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 }
 
-void np_clear(void) {
-  memset(RGB_buffer, 0, sizeof(RGB_buffer));
+// Budget courant partage par toutes les chaines (meme regulateur)
+uint32_t np_level_total(void) {
+  return 0 NP_CHAINS(NP_CHAIN_LEVEL_SUM);
 }
 
-
-void np_show(void) {
-  uint16_t *p = led_buffer;
-  for (int i = 0; i < LED_COUNT; i++) {
-    byte_to_pwm(RGB_buffer[i][0], p); p += 8; // G
-    byte_to_pwm(RGB_buffer[i][1], p); p += 8; // R
-    byte_to_pwm(RGB_buffer[i][2], p); p += 8; // B
-  }
-  for (int i = 0; i < RESET_SLOTS; i++) *p++ = 0;
-
-  __HAL_TIM_SET_AUTORELOAD(&htim1, ARR_VALUE);
-
-  HAL_TIM_PWM_Start_DMA(&htim1, TIM_CHANNEL_3,
-                        (uint32_t*)led_buffer, (uint32_t)(p - led_buffer));
-
-  while (hdma_tim1_ch3.State != HAL_DMA_STATE_READY) { }
-
-  HAL_TIM_PWM_Stop_DMA(&htim1, TIM_CHANNEL_3);
-
-}
-
-
-/*
- *
- * CIRCLE LED
- *
- */
-
-void np_set_pixel_circle(uint16_t i, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
-  if (i >= CIRCLE_LED_COUNT) return;
-  circle_RGBW_buffer[i][0] = g;
-  circle_RGBW_buffer[i][1] = r;
-  circle_RGBW_buffer[i][2] = b;
-  circle_RGBW_buffer[i][3] = w;
-}
-
-
-void np_set_all_leds_circle(uint8_t r, uint8_t g, uint8_t b, uint8_t w){
-	for (int pos = 0; pos < CIRCLE_LED_COUNT; pos++) {
-		np_set_pixel_circle(pos, r, g, b, w);
-	}
-}
-
-
-void np_clear_circle(void) {
-  memset(circle_RGBW_buffer, 0, sizeof(circle_RGBW_buffer));
-}
-
-
-void np_show_circle(void) {
-  uint16_t *p = circle_led_buffer;
-  for (int i = 0; i < CIRCLE_LED_COUNT; i++) {
-    byte_to_pwm(circle_RGBW_buffer[i][0], p); p += 8; // G
-    byte_to_pwm(circle_RGBW_buffer[i][1], p); p += 8; // R
-    byte_to_pwm(circle_RGBW_buffer[i][2], p); p += 8; // B
-    byte_to_pwm(circle_RGBW_buffer[i][3], p); p += 8; // W
-  }
-  for (int i = 0; i < RESET_SLOTS; i++) *p++ = 0;
-
-  __HAL_TIM_SET_AUTORELOAD(&htim1, ARR_VALUE);
-
-  HAL_TIM_PWM_Start_DMA(&htim1, TIM_CHANNEL_2,
-                        (uint32_t*)circle_led_buffer, (uint32_t)(p - circle_led_buffer));
-
-  // Attendre la fin du DMA
-  while (hdma_tim1_ch2.State != HAL_DMA_STATE_READY) { }
-
-  HAL_TIM_PWM_Stop_DMA(&htim1, TIM_CHANNEL_2);
-
-}
-
-
-
 /* USER CODE END FunctionPrototypes */
 
 /* GetIdleTaskMemory prototype (linked to static allocation support) */
@@ -205,6 +96,11 @@ void CircleLED_ON(void *pvParameters);
 
 void app_init(void){
 
+	np_perf_init();
+#if NP_BACKEND == NP_BACKEND_SPI
+	np_spi_init();
+#endif
+
 	xTaskCreate(LED_ON, "Barrette_LED", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
 	xTaskCreate(CircleLED_ON, "LED_Circulaire", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
 
@@ -213,25 +109,25 @@ void app_init(void){
 void LED_ON(void *pvParameters){
 	while(1){
 
-			np_clear();
+			np_stick_clear();
 			for (int pos = 0; pos < 4; pos++) {
-				np_set_pixel(pos, 255, 0, 0);
+				np_stick_set_pixel(pos, 255, 0, 0, 0);
 			}
-			for (int pos = 4; pos < LED_COUNT; pos++) {
-				np_set_pixel(pos, 0, 0, 255);
+			for (int pos = 4; pos < NP_LEDS_stick; pos++) {
+				np_stick_set_pixel(pos, 0, 0, 255, 0);
 			}
-	  	    np_show();
+	  	    np_stick_show();
 
 	  	    HAL_Delay(200);
 
-			np_clear();
+			np_stick_clear();
 			for (int pos = 0; pos < 4; pos++) {
-				np_set_pixel(pos, 0, 0, 255);
+				np_stick_set_pixel(pos, 0, 0, 255, 0);
 			}
-			for (int pos = 4; pos < LED_COUNT; pos++) {
-				np_set_pixel(pos, 255, 0, 0);
+			for (int pos = 4; pos < NP_LEDS_stick; pos++) {
+				np_stick_set_pixel(pos, 255, 0, 0, 0);
 			}
-	  	    np_show();
+	  	    np_stick_show();
 
 	  	    HAL_Delay(200);
 	}
@@ -242,15 +138,15 @@ void CircleLED_ON(void *pvParameters){
 
 	while(1){
 
-		np_clear_circle();
-		np_set_all_leds_circle(0, 0, 255, 0);
-  	    np_show_circle();
+		np_circle_clear();
+		np_circle_fill(0, 0, 255, 0);
+  	    np_circle_show();
 
   	    HAL_Delay(200);
 
-  	    np_clear_circle();
-  	    np_set_all_leds_circle(255, 0, 0, 0);
-  	    np_show_circle();
+  	    np_circle_clear();
+  	    np_circle_fill(255, 0, 0, 0);
+  	    np_circle_show();
 
   	    HAL_Delay(200);
 	}
@@ -0,0 +1,24 @@
+/**
+  ******************************************************************************
+  * @file    np_encode.c
+  * @brief   Encodage NeoPixel independant du HAL (voir np_encode.h).
+  ******************************************************************************
+  */
+#include "np_encode.h"
+
+/* 0 -> 1111 0000 0000 (0xF00), 1 -> 1111 1110 0000 (0xFE0), bit de poids fort en premier */
+const uint32_t np_spi_pair[4] = {
+  0xF00F00, 0xF00FE0, 0xFE0F00, 0xFE0FE0
+};
+
+uint16_t *np_encode_pwm(uint16_t *out, const uint8_t *px, uint8_t *residue,
+                        uint16_t nbytes, uint16_t scale)
+{
+  return np_encode_pwm_inline(out, px, residue, nbytes, scale);
+}
+
+uint8_t *np_encode_spi(uint8_t *out, const uint8_t *px, uint8_t *residue,
+                       uint16_t nbytes, uint16_t scale)
+{
+  return np_encode_spi_inline(out, px, residue, nbytes, scale);
+}
@@ -0,0 +1,106 @@
+/**
+  ******************************************************************************
+  * @file    np_spi.c
+  * @brief   Backend NeoPixel SPI (voir np_spi.h).
+  ******************************************************************************
+  */
+#include "main.h"
+
+#if NP_BACKEND == NP_BACKEND_SPI
+
+#include "np_spi.h"
+
+SPI_HandleTypeDef hspi_np[NP_SPI_COUNT];
+DMA_HandleTypeDef hdma_np_tx[NP_SPI_COUNT];
+
+typedef struct {
+  SPI_TypeDef         *spi;
+  DMA_Channel_TypeDef *dma;
+  uint32_t             request;
+  IRQn_Type            irq;
+  GPIO_TypeDef        *port;
+  uint16_t             pin;
+  uint8_t              af;
+} np_spi_hw_t;
+
+static const np_spi_hw_t s_hw[NP_SPI_COUNT] = {
+  [NP_SPI_STICK]  = { SPI2, DMA1_Channel5, DMA_REQUEST_1, DMA1_Channel5_IRQn, GPIOB, GPIO_PIN_15, GPIO_AF5_SPI2 },
+  [NP_SPI_CIRCLE] = { SPI1, DMA2_Channel4, DMA_REQUEST_4, DMA2_Channel4_IRQn, GPIOA, GPIO_PIN_7,  GPIO_AF5_SPI1 },
+};
+
+static void np_spi_init_one(np_spi_chain_t chain)
+{
+  const np_spi_hw_t *hw = &s_hw[chain];
+  SPI_HandleTypeDef *hspi = &hspi_np[chain];
+  DMA_HandleTypeDef *hdma = &hdma_np_tx[chain];
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  GPIO_InitStruct.Pin = hw->pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Pull = GPIO_PULLDOWN;     // ligne basse au repos (= reset LED)
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+  GPIO_InitStruct.Alternate = hw->af;
+  HAL_GPIO_Init(hw->port, &GPIO_InitStruct);
+
+  hdma->Instance = hw->dma;
+  hdma->Init.Request = hw->request;
+  hdma->Init.Direction = DMA_MEMORY_TO_PERIPH;
+  hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma->Init.MemInc = DMA_MINC_ENABLE;
+  hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  hdma->Init.Mode = DMA_NORMAL;
+  hdma->Init.Priority = DMA_PRIORITY_HIGH;
+  if (HAL_DMA_Init(hdma) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  __HAL_LINKDMA(hspi, hdmatx, *hdma);
+
+  HAL_NVIC_SetPriority(hw->irq, 5, 0);
+  HAL_NVIC_EnableIRQ(hw->irq);
+
+  hspi->Instance = hw->spi;
+  hspi->Init.Mode = SPI_MODE_MASTER;
+  hspi->Init.Direction = SPI_DIRECTION_1LINE;
+  hspi->Init.DataSize = SPI_DATASIZE_8BIT;
+  hspi->Init.CLKPolarity = SPI_POLARITY_LOW;
+  hspi->Init.CLKPhase = SPI_PHASE_1EDGE;
+  hspi->Init.NSS = SPI_NSS_SOFT;
+  hspi->Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_8;    // 80 MHz / 8 = 10 MHz
+  hspi->Init.FirstBit = SPI_FIRSTBIT_MSB;
+  hspi->Init.TIMode = SPI_TIMODE_DISABLE;
+  hspi->Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+  hspi->Init.CRCPolynomial = 7;
+  hspi->Init.CRCLength = SPI_CRC_LENGTH_DATASIZE;
+  hspi->Init.NSSPMode = SPI_NSS_PULSE_DISABLE;
+  if (HAL_SPI_Init(hspi) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+void np_spi_init(void)
+{
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  __HAL_RCC_DMA2_CLK_ENABLE();
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  __HAL_RCC_SPI1_CLK_ENABLE();
+  __HAL_RCC_SPI2_CLK_ENABLE();
+
+  np_spi_init_one(NP_SPI_STICK);
+  np_spi_init_one(NP_SPI_CIRCLE);
+}
+
+void np_spi_transmit(np_spi_chain_t chain, const uint8_t *buf, uint16_t len)
+{
+  SPI_HandleTypeDef *hspi = &hspi_np[chain];
+
+  if (HAL_SPI_Transmit_DMA(hspi, (uint8_t*)buf, len) != HAL_OK) return;
+
+  // Attendre la fin du DMA et du dernier octet sur MOSI
+  while (hspi->State != HAL_SPI_STATE_READY) { }
+}
+
+#endif /* NP_BACKEND == NP_BACKEND_SPI */
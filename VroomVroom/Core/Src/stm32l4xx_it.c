@@ -212,5 +212,24 @@ void DMA1_Channel7_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
+#if NP_BACKEND == NP_BACKEND_SPI
+#include "np_spi.h"
+extern DMA_HandleTypeDef hdma_np_tx[NP_SPI_COUNT];
 
+/**
+  * @brief DMA1 channel5 : SPI2_TX (barrette NeoPixel).
+  */
+void DMA1_Channel5_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_np_tx[NP_SPI_STICK]);
+}
+
+/**
+  * @brief DMA2 channel4 : SPI1_TX (anneau NeoPixel).
+  */
+void DMA2_Channel4_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_np_tx[NP_SPI_CIRCLE]);
+}
+#endif
 /* USER CODE END 1 */
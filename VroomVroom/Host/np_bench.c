@@ -0,0 +1,114 @@
+/**
+  ******************************************************************************
+  * @file    np_bench.c
+  * @brief   Micro-benchmark PC des variantes d'encodeur NeoPixel.
+  ******************************************************************************
+  * Les temps PC ne valent pas ceux du Cortex-M4 : ils servent a comparer les
+  * variantes entre elles (les cycles cible sont dans np_perf_* via DWT).
+  *
+  *   bitloop     : boucle bit a bit d'origine (byte_to_pwm), sans etage couleur
+  *   nibble_lut  : table 16 x 4 slots CCR, sans etage couleur
+  *   encode_pwm  : np_encode_pwm (gamma + echelle + dithering + reset)
+  *   encode_spi  : np_encode_spi (meme etage couleur, 12 octets par octet)
+  *   chain_pwm   : np_encode_pwm_inline a taille constante (cas np_chain.h)
+  */
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "np_encode.h"
+
+#define ITERATIONS  200000
+#define RING_BYTES  (7 * 4)
+
+static uint16_t s_pwm[RING_BYTES * 8 + NP_PWM_RESET_SLOTS];
+static uint8_t  s_spi[RING_BYTES * NP_SPI_BITS_PER_BIT + NP_SPI_RESET_SLOTS];
+static uint8_t  s_px[RING_BYTES];
+static uint8_t  s_residue[RING_BYTES];
+static volatile uint32_t s_sink;
+
+static uint16_t s_nibble_slots[16][4];
+
+static double now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void bitloop(void)
+{
+  uint16_t *p = s_pwm;
+  for (int i = 0; i < RING_BYTES; i++) {
+    for (int b = 0; b < 8; b++) {
+      p[b] = (s_px[i] & (1 << (7 - b))) ? T1H_TICKS : T0H_TICKS;
+    }
+    p += 8;
+  }
+  for (int i = 0; i < NP_PWM_RESET_SLOTS; i++) *p++ = 0;
+}
+
+static void nibble_lut(void)
+{
+  uint16_t *p = s_pwm;
+  for (int i = 0; i < RING_BYTES; i++) {
+    memcpy(p, s_nibble_slots[s_px[i] >> 4], 4 * sizeof(uint16_t));
+    memcpy(p + 4, s_nibble_slots[s_px[i] & 0x0F], 4 * sizeof(uint16_t));
+    p += 8;
+  }
+  for (int i = 0; i < NP_PWM_RESET_SLOTS; i++) *p++ = 0;
+}
+
+static void encode_pwm(void)
+{
+  np_encode_pwm(s_pwm, s_px, s_residue, RING_BYTES, 256);
+}
+
+static void encode_spi(void)
+{
+  np_encode_spi(s_spi, s_px, s_residue, RING_BYTES, 256);
+}
+
+static void chain_pwm(void)
+{
+  np_encode_pwm_inline(s_pwm, s_px, s_residue, RING_BYTES, 256);
+}
+
+static void run(const char *name, void (*fn)(void))
+{
+  for (int i = 0; i < 1000; i++) fn();   // chauffe
+
+  double t0 = now_ns();
+  for (int i = 0; i < ITERATIONS; i++) {
+    s_px[i % RING_BYTES] = (uint8_t)i;
+    fn();
+    s_sink += s_pwm[i % 64] + s_spi[i % 64];
+  }
+  double per_frame = (now_ns() - t0) / ITERATIONS;
+
+  printf("  %-11s %8.1f ns/trame  %6.2f ns/octet\n", name, per_frame, per_frame / RING_BYTES);
+}
+
+int main(void)
+{
+  for (int n = 0; n < 16; n++) {
+    for (int b = 0; b < 4; b++) {
+      s_nibble_slots[n][b] = (n & (8 >> b)) ? T1H_TICKS : T0H_TICKS;
+    }
+  }
+  for (int i = 0; i < RING_BYTES; i++) s_px[i] = (uint8_t)(i * 37);
+  np_color_set_brightness(255);
+
+  printf("np_bench : anneau GRBW (%d octets), %d trames\n", RING_BYTES, ITERATIONS);
+  run("bitloop", bitloop);
+  run("nibble_lut", nibble_lut);
+  run("encode_pwm", encode_pwm);
+  run("encode_spi", encode_spi);
+  run("chain_pwm", chain_pwm);
+
+  printf("  RAM buffer : PWM %u o, SPI %u o\n",
+         (unsigned)sizeof(s_pwm), (unsigned)sizeof(s_spi));
+  return 0;
+}
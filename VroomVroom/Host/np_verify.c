@@ -0,0 +1,375 @@
+/**
+  ******************************************************************************
+  * @file    np_verify.c
+  * @brief   Verification PC des buffers NeoPixel (np_encode_pwm / np_encode_spi).
+  ******************************************************************************
+  * Chaque buffer est reconverti en forme d'onde (niveaux + durees), puis
+  * decode bit par bit en verifiant T0H/T0L/T1H/T1L et la duree du reset
+  * contre les datasheets WS2812B (barrette) et SK6812 (anneau RGBW).
+  * Les octets decodes doivent etre ceux de l'etage couleur, dans l'ordre
+  * GRB / GRBW.
+  */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "np_encode.h"
+
+/* Durees en picosecondes */
+#define PS_PER_TICK  12500u     // TIM1 a 80 MHz
+#define PS_PER_SPI   100000u    // SPI a 10 MHz
+
+#define STICK_LEDS   8
+#define RING_LEDS    7
+#define MAX_BYTES    (RING_LEDS * 4)
+#define MAX_PULSES   (MAX_BYTES * 8 + 1)
+
+typedef struct {
+  const char *name;
+  uint32_t t0h_min, t0h_max, t0l_min, t0l_max;
+  uint32_t t1h_min, t1h_max, t1l_min, t1l_max;
+  uint32_t reset_min;
+} np_spec_t;
+
+/* ns, tolerances des datasheets */
+static const np_spec_t WS2812B = { "WS2812B", 250, 550, 700, 1000, 650, 950, 300, 600, 50000 };
+static const np_spec_t SK6812  = { "SK6812",  150, 450, 750, 1050, 450, 750, 450, 750, 80000 };
+
+typedef struct {
+  uint32_t high_ps;
+  uint32_t low_ps;
+} pulse_t;
+
+typedef struct {
+  pulse_t  p[MAX_PULSES];
+  int      n;
+} wave_t;
+
+static int failures;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+      failures++;                                               \
+      printf("  FAIL %s:%d: ", __func__, __LINE__);             \
+      printf(__VA_ARGS__);                                      \
+      printf("\n");                                             \
+    }                                                           \
+  } while (0)
+
+/* ============================ forme d'onde =============================== */
+
+static void wave_push(wave_t *w, int level, uint32_t ps)
+{
+  if (ps == 0) return;
+  if (level) {
+    /* un niveau haut apres un bas ouvre une nouvelle impulsion */
+    if (w->n == 0 || w->p[w->n - 1].low_ps != 0) {
+      if (w->n == MAX_PULSES) return;
+      w->p[w->n].high_ps = 0;
+      w->p[w->n].low_ps = 0;
+      w->n++;
+    }
+    w->p[w->n - 1].high_ps += ps;
+  } else if (w->n > 0) {
+    w->p[w->n - 1].low_ps += ps;   // bas initial (repos) ignore
+  }
+}
+
+static void wave_from_pwm(wave_t *w, const uint16_t *buf, int len)
+{
+  memset(w, 0, sizeof(*w));
+  for (int i = 0; i < len; i++) {
+    wave_push(w, 1, buf[i] * PS_PER_TICK);
+    wave_push(w, 0, (ARR_VALUE + 1u - buf[i]) * PS_PER_TICK);
+  }
+}
+
+static void wave_from_spi(wave_t *w, const uint8_t *buf, int len)
+{
+  memset(w, 0, sizeof(*w));
+  for (int i = 0; i < len; i++) {
+    for (int b = 7; b >= 0; b--) {
+      wave_push(w, (buf[i] >> b) & 1u, PS_PER_SPI);
+    }
+  }
+}
+
+static int in_range(uint32_t ps, uint32_t min_ns, uint32_t max_ns)
+{
+  return ps >= min_ns * 1000u && ps <= max_ns * 1000u;
+}
+
+/*
+ * Decode la forme d'onde en octets. Retourne le nombre d'impulsions hors
+ * spec (0 = conforme). La derniere impulsion porte le reset dans son niveau
+ * bas : seul son niveau haut sert a la classer.
+ */
+static int wave_decode(const wave_t *w, const np_spec_t *spec, uint8_t *out, int nbytes,
+                       int verbose)
+{
+  int bad = 0;
+  memset(out, 0, (size_t)nbytes);
+
+  if (w->n != nbytes * 8) {
+    if (verbose) printf("    %s: %d impulsions, %d attendues\n", spec->name, w->n, nbytes * 8);
+    return w->n + 1;
+  }
+
+  for (int i = 0; i < w->n; i++) {
+    const pulse_t *p = &w->p[i];
+    int last = (i == w->n - 1);
+    int is0 = in_range(p->high_ps, spec->t0h_min, spec->t0h_max)
+           && (last || in_range(p->low_ps, spec->t0l_min, spec->t0l_max));
+    int is1 = in_range(p->high_ps, spec->t1h_min, spec->t1h_max)
+           && (last || in_range(p->low_ps, spec->t1l_min, spec->t1l_max));
+
+    if (is0 == is1) {
+      if (verbose && bad < 4) {
+        printf("    %s: bit %d hors spec (H=%u ns L=%u ns)\n", spec->name, i,
+               (unsigned)(p->high_ps / 1000u), (unsigned)(p->low_ps / 1000u));
+      }
+      bad++;
+      /* on classe quand meme au plus proche pour comparer les couleurs */
+      is1 = p->high_ps > (spec->t0h_max + spec->t1h_min) * 500u;
+    }
+    if (is1) out[i / 8] |= (uint8_t)(0x80u >> (i % 8));
+  }
+
+  uint32_t reset_ps = w->p[w->n - 1].low_ps;
+  if (reset_ps < spec->reset_min * 1000u) {
+    if (verbose) printf("    %s: reset %u ns < %u ns\n", spec->name,
+                        (unsigned)(reset_ps / 1000u), (unsigned)spec->reset_min);
+    bad++;
+  }
+  return bad;
+}
+
+/* ================================ outils ================================= */
+
+static uint32_t s_rng = 0x12345678u;
+
+static uint8_t rnd8(void)
+{
+  s_rng = s_rng * 1664525u + 1013904223u;
+  return (uint8_t)(s_rng >> 24);
+}
+
+static void color_defaults(void)
+{
+  np_color_set_brightness(255);
+  np_color_set_budget_ma(UINT16_MAX);
+}
+
+/* Octets attendus : etage couleur applique sur une copie des residus */
+static void expected_bytes(const uint8_t *px, const uint8_t *residue, int nbytes,
+                           uint16_t scale, uint8_t *out)
+{
+  uint8_t res[MAX_BYTES];
+  memcpy(res, residue, (size_t)nbytes);
+  for (int i = 0; i < nbytes; i++) out[i] = np_color_apply(px[i], scale, &res[i]);
+}
+
+/* ================================= tests ================================= */
+
+static void test_pwm_stick_grb(void)
+{
+  uint8_t r[STICK_LEDS], g[STICK_LEDS], b[STICK_LEDS];
+  uint8_t px[STICK_LEDS * 3], residue[STICK_LEDS * 3] = {0};
+  uint8_t exp[STICK_LEDS * 3], got[STICK_LEDS * 3];
+  uint16_t buf[STICK_LEDS * 24 + NP_PWM_RESET_SLOTS];
+  wave_t w;
+
+  color_defaults();
+  for (int i = 0; i < STICK_LEDS; i++) {
+    r[i] = rnd8(); g[i] = rnd8(); b[i] = rnd8();
+    np_pack_grb(&px[i * 3], r[i], g[i], b[i]);
+  }
+  uint16_t scale = np_color_frame_scale(0);
+  expected_bytes(px, residue, sizeof(px), scale, exp);
+
+  uint16_t *end = np_encode_pwm(buf, px, residue, sizeof(px), scale);
+  CHECK(end - buf == (int)(sizeof(buf) / sizeof(buf[0])), "longueur %d", (int)(end - buf));
+
+  for (int i = 0; i < STICK_LEDS * 24; i++) {
+    CHECK(buf[i] == T0H_TICKS || buf[i] == T1H_TICKS, "slot %d = %u", i, buf[i]);
+  }
+
+  wave_from_pwm(&w, buf, (int)(end - buf));
+  CHECK(wave_decode(&w, &WS2812B, got, sizeof(got), 1) == 0, "timing WS2812B");
+  CHECK(memcmp(got, exp, sizeof(exp)) == 0, "octets decodes differents");
+
+  uint8_t res0[1] = {0};
+  for (int i = 0; i < STICK_LEDS; i++) {
+    res0[0] = 0; CHECK(got[i * 3 + 0] == np_color_apply(g[i], scale, res0), "LED %d : G", i);
+    res0[0] = 0; CHECK(got[i * 3 + 1] == np_color_apply(r[i], scale, res0), "LED %d : R", i);
+    res0[0] = 0; CHECK(got[i * 3 + 2] == np_color_apply(b[i], scale, res0), "LED %d : B", i);
+  }
+}
+
+static void test_pwm_ring_grbw(void)
+{
+  uint8_t px[RING_LEDS * 4], residue[RING_LEDS * 4] = {0};
+  uint8_t exp[RING_LEDS * 4], got[RING_LEDS * 4];
+  uint8_t w_in[RING_LEDS];
+  uint16_t buf[RING_LEDS * 32 + NP_PWM_RESET_SLOTS];
+  wave_t w;
+
+  color_defaults();
+  for (int i = 0; i < RING_LEDS; i++) {
+    w_in[i] = rnd8();
+    np_pack_grbw(&px[i * 4], rnd8(), rnd8(), rnd8(), w_in[i]);
+  }
+  uint16_t scale = np_color_frame_scale(0);
+  expected_bytes(px, residue, sizeof(px), scale, exp);
+
+  uint16_t *end = np_encode_pwm(buf, px, residue, sizeof(px), scale);
+  wave_from_pwm(&w, buf, (int)(end - buf));
+
+  CHECK(wave_decode(&w, &SK6812, got, sizeof(got), 1) == 0, "timing SK6812");
+  CHECK(wave_decode(&w, &WS2812B, got, sizeof(got), 1) == 0, "timing WS2812B");
+  CHECK(memcmp(got, exp, sizeof(exp)) == 0, "octets decodes differents");
+
+  uint8_t res0[1];
+  for (int i = 0; i < RING_LEDS; i++) {
+    res0[0] = 0;
+    CHECK(got[i * 4 + 3] == np_color_apply(w_in[i], scale, res0), "LED %d : W", i);
+  }
+}
+
+static void test_reset_length(void)
+{
+  uint8_t px[3] = {0}, residue[3] = {0};
+  uint16_t pwm[24 + NP_PWM_RESET_SLOTS];
+  uint8_t spi[3 * NP_SPI_BITS_PER_BIT + NP_SPI_RESET_SLOTS];
+
+  color_defaults();
+  uint16_t *pe = np_encode_pwm(pwm, px, residue, 3, 256);
+  uint8_t  *se = np_encode_spi(spi, px, residue, 3, 256);
+
+  int zeros = 0;
+  for (uint16_t *q = pe; q > pwm && q[-1] == 0; q--) zeros++;
+  CHECK(zeros == NP_PWM_RESET_SLOTS, "PWM : %d slots de reset", zeros);
+
+  uint32_t pwm_reset_ns = NP_PWM_RESET_SLOTS * (ARR_VALUE + 1u) * PS_PER_TICK / 1000u;
+  uint32_t spi_reset_ns = NP_SPI_RESET_SLOTS * 8u * PS_PER_SPI / 1000u;
+  CHECK(pwm_reset_ns >= SK6812.reset_min && pwm_reset_ns >= WS2812B.reset_min,
+        "PWM reset %u ns", (unsigned)pwm_reset_ns);
+  CHECK(spi_reset_ns >= SK6812.reset_min && spi_reset_ns >= WS2812B.reset_min,
+        "SPI reset %u ns", (unsigned)spi_reset_ns);
+  CHECK(se - spi == (int)sizeof(spi), "SPI : longueur %d", (int)(se - spi));
+  for (uint8_t *q = se - NP_SPI_RESET_SLOTS; q < se; q++) CHECK(*q == 0, "SPI reset non nul");
+}
+
+static void test_spi_chains(void)
+{
+  uint8_t px[RING_LEDS * 4], residue[RING_LEDS * 4] = {0};
+  uint8_t exp[RING_LEDS * 4], got[RING_LEDS * 4];
+  uint8_t buf[RING_LEDS * 4 * NP_SPI_BITS_PER_BIT + NP_SPI_RESET_SLOTS];
+  wave_t w;
+
+  color_defaults();
+  for (int i = 0; i < (int)sizeof(px); i++) px[i] = rnd8();
+  uint16_t scale = np_color_frame_scale(0);
+
+  /* barrette GRB : WS2812B */
+  expected_bytes(px, residue, STICK_LEDS * 3, scale, exp);
+  uint8_t *end = np_encode_spi(buf, px, residue, STICK_LEDS * 3, scale);
+  wave_from_spi(&w, buf, (int)(end - buf));
+  CHECK(wave_decode(&w, &WS2812B, got, STICK_LEDS * 3, 1) == 0, "SPI barrette : timing WS2812B");
+  CHECK(memcmp(got, exp, STICK_LEDS * 3) == 0, "SPI barrette : octets decodes differents");
+
+  /* anneau GRBW : SK6812 */
+  memset(residue, 0, sizeof(residue));
+  expected_bytes(px, residue, sizeof(px), scale, exp);
+  end = np_encode_spi(buf, px, residue, sizeof(px), scale);
+  wave_from_spi(&w, buf, (int)(end - buf));
+  CHECK(wave_decode(&w, &SK6812, got, sizeof(got), 1) == 0, "SPI anneau : timing SK6812");
+  CHECK(wave_decode(&w, &WS2812B, got, sizeof(got), 1) == 0, "SPI anneau : timing WS2812B");
+  CHECK(memcmp(got, exp, sizeof(exp)) == 0, "SPI anneau : octets decodes differents");
+}
+
+static void test_gamma_endpoints(void)
+{
+  uint8_t res = 0;
+  CHECK(np_color_apply(0, 256, &res) == 0 && res == 0, "gamma(0)");
+  res = 0;
+  CHECK(np_color_apply(255, 256, &res) == 255 && res == 0, "gamma(255)");
+  for (int i = 1; i < 256; i++) {
+    CHECK(np_gamma16[i] >= np_gamma16[i - 1], "gamma non monotone en %d", i);
+  }
+}
+
+static void test_dither_average(void)
+{
+  /* A valeur constante, la somme sur 256 trames vaut exactement gamma16 */
+  for (int raw = 1; raw < 64; raw++) {
+    uint8_t res = 0;
+    uint32_t sum = 0;
+    for (int f = 0; f < 256; f++) sum += np_color_apply((uint8_t)raw, 256, &res);
+    CHECK(sum == np_gamma16[raw], "raw %d : somme %u attendu %u", raw,
+          (unsigned)sum, (unsigned)np_gamma16[raw]);
+  }
+}
+
+static void test_current_budget(void)
+{
+  uint8_t stick[STICK_LEDS * 3], ring[RING_LEDS * 4];
+  uint8_t rs[sizeof(stick)] = {0}, rr[sizeof(ring)] = {0};
+  uint8_t got_s[sizeof(stick)], got_r[sizeof(ring)];
+  uint16_t bs[sizeof(stick) * 8 + NP_PWM_RESET_SLOTS];
+  uint16_t br[sizeof(ring) * 8 + NP_PWM_RESET_SLOTS];
+  wave_t w;
+
+  memset(stick, 255, sizeof(stick));
+  memset(ring, 255, sizeof(ring));
+  np_color_set_brightness(255);
+  np_color_set_budget_ma(NP_CURRENT_BUDGET_MA);
+
+  uint32_t sum = 0;
+  for (size_t i = 0; i < sizeof(stick); i++) sum += np_color_level(stick[i]);
+  for (size_t i = 0; i < sizeof(ring); i++) sum += np_color_level(ring[i]);
+  uint16_t scale = np_color_frame_scale(sum);
+  CHECK(scale < 256, "blanc complet non limite (scale %u)", scale);
+
+  uint16_t *es = np_encode_pwm(bs, stick, rs, sizeof(stick), scale);
+  uint16_t *er = np_encode_pwm(br, ring, rr, sizeof(ring), scale);
+  wave_from_pwm(&w, bs, (int)(es - bs));
+  wave_decode(&w, &WS2812B, got_s, sizeof(got_s), 0);
+  wave_from_pwm(&w, br, (int)(er - br));
+  wave_decode(&w, &SK6812, got_r, sizeof(got_r), 0);
+
+  uint32_t levels = 0;
+  for (size_t i = 0; i < sizeof(got_s); i++) levels += got_s[i];
+  for (size_t i = 0; i < sizeof(got_r); i++) levels += got_r[i];
+  uint32_t ma = levels * NP_MA_PER_CHANNEL / 255u;
+  CHECK(ma <= NP_CURRENT_BUDGET_MA, "courant estime %u mA > budget %u mA",
+        (unsigned)ma, (unsigned)NP_CURRENT_BUDGET_MA);
+  printf("  blanc complet : %u mA (budget %u mA, scale %u/256)\n",
+         (unsigned)ma, (unsigned)NP_CURRENT_BUDGET_MA, scale);
+
+  /* Luminosite globale seule : une LED, pas de limitation de courant */
+  np_color_set_brightness(128);
+  uint16_t half = np_color_frame_scale(3u * 255u);
+  CHECK(half == 129, "luminosite 128 -> scale %u", half);
+  color_defaults();
+}
+
+int main(void)
+{
+  printf("np_verify (T0H=%u T1H=%u ticks, ARR=%u)\n", T0H_TICKS, T1H_TICKS, ARR_VALUE);
+
+  test_pwm_stick_grb();
+  test_pwm_ring_grbw();
+  test_reset_length();
+  test_spi_chains();
+  test_gamma_endpoints();
+  test_dither_average();
+  test_current_budget();
+
+  if (failures) {
+    printf("%d echec(s)\n", failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}